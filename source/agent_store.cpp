@@ -0,0 +1,117 @@
+#include "agent_store.hpp"
+
+/**
+ * @brief Reserves room for a number of agents.
+ * @param count The number of agents.
+ */
+void AgentStore::reserve(int count) {
+    positionX.reserve(count);
+    positionY.reserve(count);
+    angle.reserve(count);
+    rotationCos.reserve(count);
+    rotationSin.reserve(count);
+    velocityX.reserve(count);
+    velocityY.reserve(count);
+    angularVelocity.reserve(count);
+    controls.reserve(count);
+    team.reserve(count);
+    health.reserve(count);
+    previousX.reserve(count);
+    previousY.reserve(count);
+    previousAngle.reserve(count);
+    radius.reserve(count);
+    mass.reserve(count);
+    inertia.reserve(count);
+    bodies.reserve(count);
+    aiActive.reserve(count);
+    decisionDue.reserve(count);
+    aggroTarget.reserve(count);
+    aggroCount.reserve(count);
+    visibleAgents.reserve(count);
+}
+
+/**
+ * @brief Adds an agent and fills its state from its body.
+ * @param body The body of the agent.
+ * @param radiusPixels The radius of the agent, in pixels.
+ * @param agentTeam The team of the agent.
+ * @param maxHealth The initial health.
+ * @return The ID of the agent.
+ */
+int AgentStore::add(b2Body* body, float radiusPixels, int agentTeam, float maxHealth) {
+    int id = size();
+    positionX.push_back(0);
+    positionY.push_back(0);
+    angle.push_back(0);
+    rotationCos.push_back(1);
+    rotationSin.push_back(0);
+    velocityX.push_back(0);
+    velocityY.push_back(0);
+    angularVelocity.push_back(0);
+    controls.push_back(0);
+    team.push_back((std::uint8_t)agentTeam);
+    health.push_back(maxHealth);
+    previousX.push_back(0);
+    previousY.push_back(0);
+    previousAngle.push_back(0);
+    radius.push_back(radiusPixels);
+    mass.push_back(body->GetMass());
+    inertia.push_back(body->GetInertia());
+    bodies.push_back(body);
+    aiActive.push_back(1);
+    decisionDue.push_back(1);
+    aggroTarget.push_back(-1);
+    aggroCount.push_back(0);
+    visibleAgents.emplace_back();
+
+    syncFromBody(id);
+    previousX[id] = positionX[id];
+    previousY[id] = positionY[id];
+    previousAngle[id] = angle[id];
+    return id;
+}
+
+/**
+ * @brief Copies the hot state of one agent from its body.
+ * @param id The ID of the agent.
+ */
+void AgentStore::syncFromBody(int id) {
+    const b2Body* body = bodies[id];
+    const b2Transform& transform = body->GetTransform();
+    const b2Vec2& velocity = body->GetLinearVelocity();
+    positionX[id] = transform.p.x;
+    positionY[id] = transform.p.y;
+    angle[id] = body->GetAngle();
+    rotationCos[id] = transform.q.c;
+    rotationSin[id] = transform.q.s;
+    velocityX[id] = velocity.x;
+    velocityY[id] = velocity.y;
+    angularVelocity[id] = body->GetAngularVelocity();
+}
+
+/**
+ * @brief Copies the hot state of every agent from its body, in one pass.
+ */
+void AgentStore::syncFromBodies() {
+    int count = size();
+    for(int id = 0; id < count; id++)
+        syncFromBody(id);
+}
+
+/**
+ * @brief Copies the current transform of every agent into the previous transform.
+ */
+void AgentStore::savePreviousTransforms() {
+    previousX = positionX; // Même taille : copie sans allocation
+    previousY = positionY;
+    previousAngle = angle;
+}
+
+/**
+ * @brief Gets the memory used per agent by the arrays.
+ * @return The number of bytes.
+ */
+std::size_t AgentStore::getBytesPerAgent() {
+    return 15 * sizeof(float) + 4 * sizeof(std::uint8_t) + sizeof(b2Body*) + sizeof(int) + sizeof(std::uint16_t)
+        + sizeof(std::span<const int>);
+}
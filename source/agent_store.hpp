@@ -0,0 +1,103 @@
+#pragma once
+
+#include <box2d/box2d.h>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+/**
+ * @class AgentStore
+ * @brief Structure-of-arrays storage of the state of every agent (circle) of a simulation.
+ *
+ * Each field lives in its own contiguous array indexed by agent ID, so a pass over one field
+ * (positions for the grid, controls for the forces...) only pulls that field through the cache.
+ * The hot arrays are copied from the Box2D bodies once per tick by syncFromBodies(); the bodies
+ * themselves are a side index, only touched to apply forces and when syncing.
+ */
+class AgentStore {
+public:
+    static constexpr int MAX_VISIBLE_AGENTS = 16; // Vision list size of an agent, the nearest visible agents are kept
+    static constexpr std::uint8_t DIRECTION_MASK = 0x0F; // Bits of controls read as a std::bitset<4>
+    static constexpr std::uint8_t IDLE_CONTROL = 0x10; // Bit of controls set by the decision that idles a bot, recorded for the replays
+
+    // Hot state, refreshed from the bodies every tick (meters, radians)
+    std::vector<float> positionX;
+    std::vector<float> positionY;
+    std::vector<float> angle;
+    std::vector<float> rotationCos; // cos/sin of the angle, straight from the body transform
+    std::vector<float> rotationSin;
+    std::vector<float> velocityX;
+    std::vector<float> velocityY;
+    std::vector<float> angularVelocity;
+    std::vector<std::uint8_t> controls; // std::bitset<4> of the last decision, indexed by Circle::Direction, plus IDLE_CONTROL
+    std::vector<std::uint8_t> team;
+    std::vector<float> health;
+
+    // Transform before the last world step, for the rendering interpolation
+    std::vector<float> previousX;
+    std::vector<float> previousY;
+    std::vector<float> previousAngle;
+
+    // Cold state, constant after creation
+    std::vector<float> radius; // Pixels
+    std::vector<float> mass;
+    std::vector<float> inertia;
+    std::vector<b2Body*> bodies;
+
+    // AI activity: an idle bot skips its perception and decision until something wakes it (see Simulation::updateActivity())
+    std::vector<std::uint8_t> aiActive; // 1 active, 0 idle
+    std::vector<std::uint8_t> decisionDue; // 1 from its decision slot until it is decided, see Simulation::runDecisions()
+
+    // Aggro sensors, updated from their contact events (see Simulation::updateAggro())
+    std::vector<int> aggroTarget; // An enemy inside the aggro radius, -1 if none
+    std::vector<std::uint16_t> aggroCount; // Number of enemies inside the aggro radius
+
+    // Results of the perception phase, in the frame arena of the tick (see FrameArena)
+    std::vector<std::span<const int>> visibleAgents; // IDs of the agents each agent sees, until the next tick starts
+
+    /**
+     * @brief Reserves room for a number of agents.
+     * @param count The number of agents.
+     */
+    void reserve(int count);
+
+    /**
+     * @brief Adds an agent and fills its state from its body.
+     * @param body The body of the agent.
+     * @param radiusPixels The radius of the agent, in pixels.
+     * @param agentTeam The team of the agent.
+     * @param maxHealth The initial health.
+     * @return The ID of the agent.
+     */
+    int add(b2Body* body, float radiusPixels, int agentTeam, float maxHealth);
+
+    /**
+     * @brief Copies the hot state of every agent from its body, in one pass.
+     */
+    void syncFromBodies();
+
+    /**
+     * @brief Copies the current transform of every agent into the previous transform.
+     */
+    void savePreviousTransforms();
+
+    /**
+     * @brief Copies the hot state of one agent from its body.
+     * @param id The ID of the agent.
+     */
+    void syncFromBody(int id);
+
+    int size() const { return (int)bodies.size(); }
+
+    /**
+     * @brief Gets the IDs of the agents seen by an agent, in no particular order.
+     * @param id The ID of the agent.
+     */
+    std::span<const int> getVisibleAgents(int id) const { return visibleAgents[id]; }
+
+    /**
+     * @brief Gets the memory used per agent by the arrays.
+     * @return The number of bytes.
+     */
+    static std::size_t getBytesPerAgent();
+};
@@ -0,0 +1,185 @@
+#include "allocation_tracker.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+// Types triviaux : pas d'initialisation dynamique, utilisables dès la première allocation d'un thread
+static thread_local AllocationCounts t_counts;
+static std::atomic<long long> s_allocations{ 0 };
+static std::atomic<long long> s_bytes{ 0 };
+static std::atomic<long long> s_frees{ 0 };
+
+static void* countedAlloc(std::size_t size) {
+    t_counts.allocations++;
+    t_counts.bytes += (long long)size;
+    s_allocations.fetch_add(1, std::memory_order_relaxed);
+    s_bytes.fetch_add((long long)size, std::memory_order_relaxed);
+    return std::malloc(size ? size : 1); // new doit rendre un pointeur unique même pour 0 octet
+}
+
+static void countedFree(void* memory) {
+    if(!memory)
+        return;
+    t_counts.frees++;
+    s_frees.fetch_add(1, std::memory_order_relaxed);
+    std::free(memory);
+}
+
+static void* countedAlignedAlloc(std::size_t size, std::align_val_t alignment) {
+    t_counts.allocations++;
+    t_counts.bytes += (long long)size;
+    s_allocations.fetch_add(1, std::memory_order_relaxed);
+    s_bytes.fetch_add((long long)size, std::memory_order_relaxed);
+    std::size_t align = (std::size_t)alignment;
+#ifdef _WIN32
+    return _aligned_malloc(size ? size : 1, align); // MSVC n'a pas std::aligned_alloc
+#else
+    return std::aligned_alloc(align, (std::max<std::size_t>(size, 1) + align - 1) / align * align); // Taille multiple de l'alignement
+#endif
+}
+
+static void countedAlignedFree(void* memory) {
+    if(!memory)
+        return;
+    t_counts.frees++;
+    s_frees.fetch_add(1, std::memory_order_relaxed);
+#ifdef _WIN32
+    _aligned_free(memory);
+#else
+    std::free(memory);
+#endif
+}
+
+/**
+ * @brief Gets the counts of the calling thread since it started, charged work included.
+ */
+AllocationCounts AllocationTracker::getThreadCounts() {
+    return t_counts;
+}
+
+/**
+ * @brief Gets the counts of the whole process since it started.
+ */
+AllocationCounts AllocationTracker::getTotalCounts() {
+    return { s_allocations.load(std::memory_order_relaxed), s_bytes.load(std::memory_order_relaxed), s_frees.load(std::memory_order_relaxed) };
+}
+
+/**
+ * @brief Adds counts measured on another thread to the calling thread.
+ * @param counts The counts to add.
+ */
+void AllocationTracker::chargeToThread(const AllocationCounts& counts) {
+    t_counts += counts;
+}
+
+/**
+ * @brief Counted allocation for Box2D, see b2_user_settings.h.
+ * @param size The number of bytes.
+ * @return The memory.
+ */
+void* AllocationTracker::box2dAlloc(int size) {
+    return countedAlloc((std::size_t)size);
+}
+
+/**
+ * @brief Counted free for Box2D, see b2_user_settings.h.
+ * @param memory The memory returned by box2dAlloc().
+ */
+void AllocationTracker::box2dFree(void* memory) {
+    countedFree(memory);
+}
+
+// Remplacements des opérateurs globaux : toutes les allocations du programme (STL, SFML, TGUI...) passent par ici
+
+void* operator new(std::size_t size) {
+    void* memory = countedAlloc(size);
+    if(!memory)
+        throw std::bad_alloc();
+    return memory;
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return countedAlloc(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return countedAlloc(size);
+}
+
+void operator delete(void* memory) noexcept {
+    countedFree(memory);
+}
+
+void operator delete[](void* memory) noexcept {
+    countedFree(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept {
+    countedFree(memory);
+}
+
+void operator delete[](void* memory, std::size_t) noexcept {
+    countedFree(memory);
+}
+
+void operator delete(void* memory, const std::nothrow_t&) noexcept {
+    countedFree(memory);
+}
+
+void operator delete[](void* memory, const std::nothrow_t&) noexcept {
+    countedFree(memory);
+}
+
+// Formes alignées (alignas au-delà de __STDCPP_DEFAULT_NEW_ALIGNMENT__) : comptées de la même façon
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    void* memory = countedAlignedAlloc(size, alignment);
+    if(!memory)
+        throw std::bad_alloc();
+    return memory;
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    return operator new(size, alignment);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return countedAlignedAlloc(size, alignment);
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return countedAlignedAlloc(size, alignment);
+}
+
+void operator delete(void* memory, std::align_val_t) noexcept {
+    countedAlignedFree(memory);
+}
+
+void operator delete[](void* memory, std::align_val_t) noexcept {
+    countedAlignedFree(memory);
+}
+
+void operator delete(void* memory, std::size_t, std::align_val_t) noexcept {
+    countedAlignedFree(memory);
+}
+
+void operator delete[](void* memory, std::size_t, std::align_val_t) noexcept {
+    countedAlignedFree(memory);
+}
+
+void operator delete(void* memory, std::align_val_t, const std::nothrow_t&) noexcept {
+    countedAlignedFree(memory);
+}
+
+void operator delete[](void* memory, std::align_val_t, const std::nothrow_t&) noexcept {
+    countedAlignedFree(memory);
+}
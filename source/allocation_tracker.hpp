@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstddef>
+
+/**
+ * @struct AllocationCounts
+ * @brief Number of heap allocations and frees, and bytes allocated.
+ */
+struct AllocationCounts {
+    long long allocations{ 0 };
+    long long bytes{ 0 }; // Allocated, frees are not subtracted
+    long long frees{ 0 };
+
+    AllocationCounts operator-(const AllocationCounts& other) const {
+        return { allocations - other.allocations, bytes - other.bytes, frees - other.frees };
+    }
+    AllocationCounts& operator+=(const AllocationCounts& other) {
+        allocations += other.allocations;
+        bytes += other.bytes;
+        frees += other.frees;
+        return *this;
+    }
+};
+
+/**
+ * @class AllocationTracker
+ * @brief Counts every heap allocation of the process, through the replacements of the global operator new and delete.
+ *
+ * Each thread has its own counts, so a phase can be measured while other threads allocate.
+ * ThreadPool charges the allocations of its workers to the thread that called parallelFor(), so
+ * the counts of a thread include the work it handed out.
+ *
+ * Box2D allocates with b2Alloc()/b2Free(), which call malloc in the library. To count them too,
+ * Box2D must be built with B2_USER_SETTINGS and the b2_user_settings.h of this folder, which routes
+ * them to box2dAlloc()/box2dFree(); the prebuilt box2d.lib does not.
+ */
+class AllocationTracker {
+public:
+    /**
+     * @brief Gets the counts of the calling thread since it started, charged work included.
+     */
+    static AllocationCounts getThreadCounts();
+
+    /**
+     * @brief Gets the counts of the whole process since it started.
+     */
+    static AllocationCounts getTotalCounts();
+
+    /**
+     * @brief Adds counts measured on another thread to the calling thread.
+     * @param counts The counts to add.
+     */
+    static void chargeToThread(const AllocationCounts& counts);
+
+    /**
+     * @brief Counted allocation for Box2D, see b2_user_settings.h.
+     * @param size The number of bytes.
+     * @return The memory.
+     */
+    static void* box2dAlloc(int size);
+
+    /**
+     * @brief Counted free for Box2D, see b2_user_settings.h.
+     * @param memory The memory returned by box2dAlloc().
+     */
+    static void box2dFree(void* memory);
+};
+
+/**
+ * @class AllocationScope
+ * @brief Measures the allocations of the calling thread from its construction on.
+ */
+class AllocationScope {
+private:
+    AllocationCounts m_start;
+
+public:
+    AllocationScope() : m_start(AllocationTracker::getThreadCounts()) {}
+
+    /**
+     * @brief Gets the allocations made since the construction.
+     */
+    AllocationCounts getCounts() const { return AllocationTracker::getThreadCounts() - m_start; }
+};
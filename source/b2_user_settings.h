@@ -0,0 +1,70 @@
+#pragma once
+
+/*
+Réglages de Box2D qui comptent ses allocations dans AllocationTracker.
+Utilisé uniquement si Box2D est recompilé avec B2_USER_SETTINGS défini et ce dossier dans ses includes
+(le jeu doit alors définir B2_USER_SETTINGS lui aussi). La box2d.lib fournie est compilée sans :
+b2Alloc y appelle malloc directement et ses allocations ne sont pas comptées.
+Le reste est une copie des valeurs par défaut de b2_settings.h (Box2D 2.4.1).
+*/
+
+#include <stdarg.h>
+#include <stdint.h>
+
+#include "allocation_tracker.hpp"
+
+#define b2_lengthUnitsPerMeter 1.0f
+#define b2_maxPolygonVertices	8
+
+struct B2_API b2BodyUserData
+{
+	b2BodyUserData()
+	{
+		pointer = 0;
+	}
+
+	uintptr_t pointer;
+};
+
+struct B2_API b2FixtureUserData
+{
+	b2FixtureUserData()
+	{
+		pointer = 0;
+	}
+
+	uintptr_t pointer;
+};
+
+struct B2_API b2JointUserData
+{
+	b2JointUserData()
+	{
+		pointer = 0;
+	}
+
+	uintptr_t pointer;
+};
+
+B2_API void* b2Alloc_Default(int32 size);
+B2_API void b2Free_Default(void* mem);
+
+inline void* b2Alloc(int32 size)
+{
+	return AllocationTracker::box2dAlloc(size);
+}
+
+inline void b2Free(void* mem)
+{
+	AllocationTracker::box2dFree(mem);
+}
+
+B2_API void b2Log_Default(const char* string, va_list args);
+
+inline void b2Log(const char* string, ...)
+{
+	va_list args;
+	va_start(args, string);
+	b2Log_Default(string, args);
+	va_end(args);
+}
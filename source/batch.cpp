@@ -0,0 +1,50 @@
+#include "batch.hpp"
+
+#include <chrono>
+
+/**
+ * @brief Starts the thread pool used to run the battles.
+ * @param settings The batch parameters.
+ */
+BatchRunner::BatchRunner(const BatchSettings& settings)
+    : m_settings(settings), m_pool(settings.threadCount)
+{
+}
+
+/**
+ * @brief Runs every battle of the batch and waits for all of them.
+ * @return The result of each battle, indexed by battle.
+ */
+std::vector<BattleResult> BatchRunner::run() {
+    std::vector<BattleResult> results(m_settings.battleCount);
+
+    auto batchStart = std::chrono::steady_clock::now();
+    m_pool.parallelFor(m_settings.battleCount, [&](int battleIndex) {
+        auto start = std::chrono::steady_clock::now();
+
+        SimulationSettings settings = m_settings.simulation;
+        settings.hasPlayer = false;
+        settings.seed = m_settings.simulation.seed + battleIndex;
+        Simulation simulation(settings);
+
+        TickInput input;
+        input.botTarget = settings.arenaSize / 2.f;
+        while(!simulation.isFinished() && simulation.getTickCount() < m_settings.maxTicks)
+            simulation.step(input);
+
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        results[battleIndex] = { battleIndex, settings.seed, simulation.getTickCount(), simulation.getWinnerID(), elapsed.count() };
+    });
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - batchStart;
+    m_elapsedSeconds = elapsed.count();
+
+    return results;
+}
+
+/**
+ * @brief Gets the throughput of the last run.
+ * @return The number of battles completed per second of wall-clock time.
+ */
+double BatchRunner::getBattlesPerSecond() const {
+    return m_elapsedSeconds > 0 ? m_settings.battleCount / m_elapsedSeconds : 0;
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <vector>
+
+#include "simulation.hpp"
+#include "thread_pool.hpp"
+
+/**
+ * @struct BattleResult
+ * @brief Outcome of one battle run by the BatchRunner.
+ */
+struct BattleResult {
+    int battleIndex;
+    std::uint32_t seed; // Seed of the battle, enough to run it again
+    long long ticks; // Ticks simulated before the battle ended
+    int winnerID; // ID of the winning circle, -1 if the tick limit was reached first
+    double seconds; // Wall-clock time spent on the battle
+};
+
+/**
+ * @struct BatchSettings
+ * @brief Parameters of a batch of independent battles.
+ */
+struct BatchSettings {
+    int battleCount{ 100 };
+    long long maxTicks{ 10000 }; // A battle without winner stops after this many ticks
+    int threadCount{ 0 }; // 0 uses every hardware thread
+    SimulationSettings simulation; // Battle i uses the seed simulation.seed + i
+};
+
+/**
+ * @class BatchRunner
+ * @brief Runs many independent headless battles in parallel, one Simulation per battle.
+ */
+class BatchRunner {
+private:
+    BatchSettings m_settings;
+    ThreadPool m_pool;
+    double m_elapsedSeconds{ 0 };
+
+public:
+    /**
+     * @brief Starts the thread pool used to run the battles.
+     * @param settings The batch parameters.
+     */
+    explicit BatchRunner(const BatchSettings& settings);
+
+    /**
+     * @brief Runs every battle of the batch and waits for all of them.
+     * @return The result of each battle, indexed by battle.
+     */
+    std::vector<BattleResult> run();
+
+    /**
+     * @brief Gets the throughput of the last run.
+     * @return The number of battles completed per second of wall-clock time.
+     */
+    double getBattlesPerSecond() const;
+
+    int getThreadCount() const { return m_pool.getThreadCount(); }
+};
@@ -0,0 +1,195 @@
+#include "benchmark.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+
+static constexpr std::uint32_t BENCHMARK_SEED = 12345;
+static constexpr int BASE_CIRCLE_COUNT = 20; // Le jeu actuel : 20 cercles dans une arène de la taille de la fenêtre
+
+/**
+ * @brief Builds the settings of an arena with the density of the game: the arena grows with the circle count.
+ * @param circleCount The number of circles.
+ * @return The settings.
+ */
+static SimulationSettings makeArena(int circleCount) {
+    SimulationSettings settings;
+    settings.seed = BENCHMARK_SEED;
+    settings.hasPlayer = false;
+    settings.circleCount = circleCount;
+    float scale = std::sqrt((float)circleCount / BASE_CIRCLE_COUNT);
+    settings.arenaSize = sf::Vector2f(std::round(WINDOW_WIDTH * scale), std::round(WINDOW_HEIGHT * scale));
+    return settings;
+}
+
+/**
+ * @brief Gets the name of a phase or a counter without the indentation used by the overlay.
+ */
+static const char* trimName(const char* name) {
+    while(*name == ' ')
+        name++;
+    return name;
+}
+
+/**
+ * @brief Gets the standard suite: the 20-circle arena, 200 / 2,000 / 20,000 circles at the same
+ * density, a dense clump, and vision on vs off.
+ */
+std::vector<BenchmarkScenario> Benchmark::getStandardScenarios() {
+    std::vector<BenchmarkScenario> scenarios;
+    scenarios.push_back({ "arena-20", makeArena(20), 120, 2000 });
+    scenarios.push_back({ "arena-200", makeArena(200), 120, 1000 });
+    scenarios.push_back({ "arena-2000", makeArena(2000), 120, 500 });
+    scenarios.push_back({ "arena-20000", makeArena(20000), 60, 100 });
+
+    // Deux tiers de l'arène couverts de cercles, qui convergent tous vers le centre pendant le préchauffage
+    BenchmarkScenario clump{ "clump-2000", makeArena(2000), 600, 500 };
+    clump.settings.arenaSize = sf::Vector2f(2500.f, 1500.f);
+    scenarios.push_back(clump);
+
+    BenchmarkScenario visionOff{ "arena-2000-no-vision", makeArena(2000), 120, 500 };
+    visionOff.settings.visionEnabled = false;
+    scenarios.push_back(visionOff);
+
+    // Chaque bot décide 10 fois par seconde au lieu de 120 : un douzième des bots par tick
+    BenchmarkScenario sliced{ "arena-20000-ai-10hz", makeArena(20000), 60, 100 };
+    sliced.settings.aiDecisionRate = 10.f;
+    scenarios.push_back(sliced);
+
+    // Les bots ne chassent que les ennemis proches : la plupart sont inactifs, leurs corps endormis
+    BenchmarkScenario idle{ "idle-20000", makeArena(20000), 240, 100 };
+    idle.settings.botsChaseEnemies = true;
+    idle.settings.chaseRange = 3 * idle.settings.circleRadius;
+    scenarios.push_back(idle);
+    return scenarios;
+}
+
+/**
+ * @brief Runs one scenario.
+ * @param scenario The scenario.
+ * @param threadPool The pool of the perception and decision phases, nullptr runs them on the calling thread.
+ * @return The measurements.
+ */
+BenchmarkResult Benchmark::run(const BenchmarkScenario& scenario, ThreadPool* threadPool) {
+    BenchmarkResult result;
+    result.scenario = scenario;
+    result.threadCount = threadPool ? threadPool->getThreadCount() : 1;
+
+    Simulation simulation(scenario.settings);
+    simulation.setThreadPool(threadPool);
+    TickInput input;
+    input.botTarget = scenario.settings.arenaSize / 2.f;
+    for(long long i = 0; i < scenario.warmupTicks; i++)
+        simulation.step(input);
+
+    Profiler profiler;
+    simulation.setProfiler(&profiler);
+    AllocationScope allocations;
+    auto start = std::chrono::steady_clock::now();
+    for(long long i = 0; i < scenario.ticks; i++)
+        simulation.step(input);
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    result.allocations = allocations.getCounts();
+    simulation.setProfiler(nullptr);
+
+    result.seconds = elapsed.count();
+    result.ticksPerSecond = result.seconds > 0 ? scenario.ticks / result.seconds : 0.;
+    double agentTicks = (double)scenario.ticks * scenario.settings.circleCount;
+    result.nanosecondsPerAgentTick = agentTicks > 0 ? result.seconds * 1e9 / agentTicks : 0.;
+    profiler.saveReport(result.profile);
+    return result;
+}
+
+/**
+ * @brief Prints the measurements of one scenario and its per-phase breakdown.
+ * @param out The stream to write to.
+ * @param result The measurements.
+ */
+void Benchmark::print(std::ostream& out, const BenchmarkResult& result) {
+    const SimulationSettings& settings = result.scenario.settings;
+    out << result.scenario.name << ": " << settings.circleCount << " circles, " << settings.arenaSize.x << "x" << settings.arenaSize.y
+        << " px, vision " << (settings.visionEnabled ? "on" : "off") << ", " << result.scenario.ticks << " ticks in " << result.seconds
+        << " s (" << result.ticksPerSecond << " ticks/s, " << result.nanosecondsPerAgentTick << " ns/agent/tick), "
+        << result.allocations.allocations << " heap allocations (" << result.allocations.bytes << " bytes)" << std::endl;
+
+    std::ios::fmtflags flags = out.flags();
+    out << std::fixed << std::setprecision(3);
+    for(int i = 0; i < (int)ProfilePhase::Count; i++) {
+        const ProfileStats& stats = result.profile.phases[i];
+        if(stats.sampleCount > 0)
+            out << "    " << std::left << std::setw(18) << Profiler::getName((ProfilePhase)i) << std::right
+                << " avg " << std::setw(8) << stats.average << " ms   p99 " << std::setw(8) << stats.p99 << " ms   allocs "
+                << std::setprecision(1) << std::setw(6) << result.profile.phaseAllocations[i].average << std::setprecision(3) << std::endl;
+    }
+    out << std::setprecision(0);
+    for(int i = 0; i < (int)ProfileCounter::Count; i++) {
+        const ProfileStats& stats = result.profile.counters[i];
+        if(stats.sampleCount > 0)
+            out << "    " << std::left << std::setw(18) << Profiler::getName((ProfileCounter)i) << std::right
+                << " avg " << std::setw(8) << stats.average << "      p99 " << std::setw(8) << stats.p99 << std::endl;
+    }
+    out.flags(flags);
+}
+
+/**
+ * @brief Writes the statistics of a phase or a counter as a JSON object.
+ */
+static void writeJsonStats(std::ostream& out, const char* name, const ProfileStats& stats) {
+    out << "\"" << trimName(name) << "\": { \"min\": " << stats.min << ", \"avg\": " << stats.average << ", \"p99\": " << stats.p99 << " }";
+}
+
+/**
+ * @brief Writes the measurements of the whole suite as JSON.
+ * @param out The stream to write to.
+ * @param results The measurements of each scenario.
+ */
+void Benchmark::writeJson(std::ostream& out, const std::vector<BenchmarkResult>& results) {
+    out << "{\n  \"instructionSet\": \"" << Steering::getInstructionSet() << "\",\n  \"scenarios\": [";
+    for(std::size_t r = 0; r < results.size(); r++) {
+        const BenchmarkResult& result = results[r];
+        const SimulationSettings& settings = result.scenario.settings;
+        out << (r ? "," : "") << "\n    {\n"
+            << "      \"name\": \"" << result.scenario.name << "\",\n"
+            << "      \"seed\": " << settings.seed << ",\n"
+            << "      \"circles\": " << settings.circleCount << ",\n"
+            << "      \"arena\": [" << settings.arenaSize.x << ", " << settings.arenaSize.y << "],\n"
+            << "      \"vision\": " << (settings.visionEnabled ? "true" : "false") << ",\n"
+            << "      \"threads\": " << result.threadCount << ",\n"
+            << "      \"warmupTicks\": " << result.scenario.warmupTicks << ",\n"
+            << "      \"ticks\": " << result.scenario.ticks << ",\n"
+            << "      \"seconds\": " << result.seconds << ",\n"
+            << "      \"ticksPerSecond\": " << result.ticksPerSecond << ",\n"
+            << "      \"nsPerAgentTick\": " << result.nanosecondsPerAgentTick << ",\n"
+            << "      \"allocations\": " << result.allocations.allocations << ",\n"
+            << "      \"allocatedBytes\": " << result.allocations.bytes << ",\n"
+            << "      \"phasesMs\": {";
+        bool first = true;
+        for(int i = 0; i < (int)ProfilePhase::Count; i++) {
+            if(result.profile.phases[i].sampleCount == 0)
+                continue;
+            out << (first ? "\n        " : ",\n        ");
+            writeJsonStats(out, Profiler::getName((ProfilePhase)i), result.profile.phases[i]);
+            first = false;
+        }
+        out << "\n      },\n      \"phaseAllocations\": {";
+        first = true;
+        for(int i = 0; i < (int)ProfilePhase::Count; i++) {
+            if(result.profile.phaseAllocations[i].sampleCount == 0)
+                continue;
+            out << (first ? "\n        " : ",\n        ");
+            writeJsonStats(out, Profiler::getName((ProfilePhase)i), result.profile.phaseAllocations[i]);
+            first = false;
+        }
+        out << "\n      },\n      \"counters\": {";
+        first = true;
+        for(int i = 0; i < (int)ProfileCounter::Count; i++) {
+            if(result.profile.counters[i].sampleCount == 0)
+                continue;
+            out << (first ? "\n        " : ",\n        ");
+            writeJsonStats(out, Profiler::getName((ProfileCounter)i), result.profile.counters[i]);
+            first = false;
+        }
+        out << "\n      }\n    }";
+    }
+    out << "\n  ]\n}\n";
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "profiler.hpp"
+#include "simulation.hpp"
+#include "thread_pool.hpp"
+
+/**
+ * @struct BenchmarkScenario
+ * @brief One fixed-seed headless run of the benchmark suite.
+ */
+struct BenchmarkScenario {
+    std::string name;
+    SimulationSettings settings;
+    long long warmupTicks{ 0 }; // Run before timing, to let the circles spread or clump
+    long long ticks{ 1000 }; // Timed ticks
+};
+
+/**
+ * @struct BenchmarkResult
+ * @brief Measurements of one scenario.
+ */
+struct BenchmarkResult {
+    BenchmarkScenario scenario;
+    int threadCount{ 1 };
+    double seconds{ 0 }; // Wall-clock time of the timed ticks
+    double ticksPerSecond{ 0 };
+    double nanosecondsPerAgentTick{ 0 };
+    ProfileReport profile; // Over the last Profiler::HISTORY_SIZE timed ticks
+    AllocationCounts allocations; // Over all the timed ticks, pool workers included
+};
+
+/**
+ * @class Benchmark
+ * @brief Standard headless scenarios, run with a profiler and reported as text and JSON.
+ *
+ * Every scenario uses a fixed seed, so two runs of the suite simulate exactly the same battles
+ * and their numbers can be compared from one build to the next.
+ */
+class Benchmark {
+public:
+    /**
+     * @brief Gets the standard suite: the 20-circle arena, 200 / 2,000 / 20,000 circles at the same
+     * density, a dense clump, and vision on vs off.
+     */
+    static std::vector<BenchmarkScenario> getStandardScenarios();
+
+    /**
+     * @brief Runs one scenario.
+     * @param scenario The scenario.
+     * @param threadPool The pool of the perception and decision phases, nullptr runs them on the calling thread.
+     * @return The measurements.
+     */
+    static BenchmarkResult run(const BenchmarkScenario& scenario, ThreadPool* threadPool);
+
+    /**
+     * @brief Prints the measurements of one scenario and its per-phase breakdown.
+     * @param out The stream to write to.
+     * @param result The measurements.
+     */
+    static void print(std::ostream& out, const BenchmarkResult& result);
+
+    /**
+     * @brief Writes the measurements of the whole suite as JSON.
+     * @param out The stream to write to.
+     * @param results The measurements of each scenario.
+     */
+    static void writeJson(std::ostream& out, const std::vector<BenchmarkResult>& results);
+};
@@ -0,0 +1,55 @@
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "benchmark.hpp"
+
+static constexpr const char* USAGE = "[--threads N] [--only NAME] [--json FILE]";
+static constexpr const char* DEFAULT_JSON_PATH = "benchmark_results.json";
+
+/**
+ * @brief Entry point of the benchmark executable: runs the standard scenarios and writes their results.
+ *
+ * Usage: benchmark [--threads N] [--only NAME] [--json FILE]
+ * --only runs the scenarios whose name contains NAME. The JSON goes to benchmark_results.json by default.
+ */
+int main(int argc, char* argv[]) {
+    int threadCount = 0; // Tous les threads matériels
+    std::string only;
+    std::string jsonPath = DEFAULT_JSON_PATH;
+
+    for(int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if(arg == "--threads" && i + 1 < argc)
+            threadCount = std::stoi(argv[++i]);
+        else if(arg == "--only" && i + 1 < argc)
+            only = argv[++i];
+        else if(arg == "--json" && i + 1 < argc)
+            jsonPath = argv[++i];
+        else {
+            std::cerr << "Unknown argument: " << arg << std::endl;
+            std::cerr << "Usage: " << argv[0] << " " << USAGE << std::endl;
+            return 1;
+        }
+    }
+
+    ThreadPool threadPool(threadCount);
+    std::cout << "Benchmark on " << threadPool.getThreadCount() << " threads, " << Steering::getInstructionSet() << " steering" << std::endl;
+
+    std::vector<BenchmarkResult> results;
+    for(const BenchmarkScenario& scenario : Benchmark::getStandardScenarios()) {
+        if(!only.empty() && scenario.name.find(only) == std::string::npos)
+            continue;
+        results.push_back(Benchmark::run(scenario, &threadPool));
+        Benchmark::print(std::cout, results.back());
+    }
+
+    std::ofstream json(jsonPath);
+    Benchmark::writeJson(json, results);
+    if(!json) {
+        std::cerr << "Cannot write " << jsonPath << std::endl;
+        return 1;
+    }
+    std::cout << "Results written to " << jsonPath << std::endl;
+    return 0;
+}
@@ -0,0 +1,90 @@
+#include "camera.hpp"
+
+#include <algorithm>
+
+static constexpr float ZOOM_STEP = 1.2f; // Facteur de zoom par cran de molette
+static constexpr float MIN_ZOOM = 1.f / 16; // Zoom maximal : un pixel du monde fait 16 pixels écran
+static constexpr float MAX_ZOOM_ARENAS = 2.f; // Dézoom maximal, en arènes entières dans la fenêtre
+
+/**
+ * @brief Constructs a Camera showing the whole arena.
+ * @param window The window the camera draws to.
+ * @param arenaSize The size of the arena, in pixels.
+ */
+Camera::Camera(const sf::RenderWindow& window, sf::Vector2f arenaSize)
+    : m_arenaSize(arenaSize)
+{
+    fitArena(window);
+}
+
+/**
+ * @brief Zooms and centres the view so that the whole arena fits in the window.
+ * @param window The window the camera draws to.
+ */
+void Camera::fitArena(const sf::RenderWindow& window) {
+    sf::Vector2f windowSize(window.getSize());
+    m_zoom = std::max(m_arenaSize.x / windowSize.x, m_arenaSize.y / windowSize.y);
+    m_view.setSize(windowSize * m_zoom);
+    m_view.setCenter(m_arenaSize / 2.f);
+}
+
+void Camera::setZoom(float zoom, const sf::RenderWindow& window) {
+    sf::Vector2f windowSize(window.getSize());
+    float maxZoom = MAX_ZOOM_ARENAS * std::max(m_arenaSize.x / windowSize.x, m_arenaSize.y / windowSize.y);
+    m_zoom = std::clamp(zoom, MIN_ZOOM, std::max(MIN_ZOOM, maxZoom));
+    m_view.setSize(windowSize * m_zoom);
+}
+
+/**
+ * @brief Zooms, pans or resizes the view according to a window event.
+ * @param event The event.
+ * @param window The window the event comes from.
+ */
+void Camera::handleEvent(const sf::Event& event, const sf::RenderWindow& window) {
+    switch(event.type) {
+        case sf::Event::MouseWheelScrolled: {
+            // Le point du monde sous le curseur reste sous le curseur
+            sf::Vector2i mouse(event.mouseWheelScroll.x, event.mouseWheelScroll.y);
+            sf::Vector2f before = window.mapPixelToCoords(mouse, m_view);
+            setZoom(event.mouseWheelScroll.delta > 0 ? m_zoom / ZOOM_STEP : m_zoom * ZOOM_STEP, window);
+            sf::Vector2f after = window.mapPixelToCoords(mouse, m_view);
+            m_view.move(before - after);
+            break;
+        }
+        case sf::Event::MouseButtonPressed:
+            if(event.mouseButton.button == sf::Mouse::Right || event.mouseButton.button == sf::Mouse::Middle) {
+                m_dragging = true;
+                m_lastMousePosition = sf::Vector2i(event.mouseButton.x, event.mouseButton.y);
+            }
+            break;
+        case sf::Event::MouseButtonReleased:
+            if(event.mouseButton.button == sf::Mouse::Right || event.mouseButton.button == sf::Mouse::Middle)
+                m_dragging = false;
+            break;
+        case sf::Event::MouseMoved:
+            if(m_dragging) {
+                sf::Vector2i mouse(event.mouseMove.x, event.mouseMove.y);
+                m_view.move(sf::Vector2f(m_lastMousePosition - mouse) * m_zoom);
+                m_lastMousePosition = mouse;
+            }
+            break;
+        case sf::Event::KeyPressed:
+            if(event.key.code == sf::Keyboard::Home)
+                fitArena(window);
+            break;
+        case sf::Event::Resized:
+            setZoom(m_zoom, window); // Même échelle, plus ou moins d'arène visible
+            break;
+        default:
+            break;
+    }
+}
+
+/**
+ * @brief Gets the part of the arena currently on screen.
+ * @return The rectangle, in pixels.
+ */
+sf::FloatRect Camera::getVisibleArea() const {
+    sf::Vector2f size = m_view.getSize();
+    return sf::FloatRect(m_view.getCenter() - size / 2.f, size);
+}
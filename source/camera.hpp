@@ -0,0 +1,50 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+
+/**
+ * @class Camera
+ * @brief sf::View over the arena that the player can zoom and pan, so that the arena can be larger than the window.
+ *
+ * Mouse wheel zooms around the cursor, dragging with the right or middle button pans, Home fits the whole arena.
+ */
+class Camera {
+private:
+    sf::View m_view;
+    sf::Vector2f m_arenaSize; // Pixels
+    float m_zoom{ 1.f }; // World pixels per screen pixel
+    bool m_dragging{ false };
+    sf::Vector2i m_lastMousePosition; // Screen pixels, while dragging
+
+    void setZoom(float zoom, const sf::RenderWindow& window);
+
+public:
+    /**
+     * @brief Constructs a Camera showing the whole arena.
+     * @param window The window the camera draws to.
+     * @param arenaSize The size of the arena, in pixels.
+     */
+    Camera(const sf::RenderWindow& window, sf::Vector2f arenaSize);
+
+    /**
+     * @brief Zooms and centres the view so that the whole arena fits in the window.
+     * @param window The window the camera draws to.
+     */
+    void fitArena(const sf::RenderWindow& window);
+
+    /**
+     * @brief Zooms, pans or resizes the view according to a window event.
+     * @param event The event.
+     * @param window The window the event comes from.
+     */
+    void handleEvent(const sf::Event& event, const sf::RenderWindow& window);
+
+    /**
+     * @brief Gets the part of the arena currently on screen.
+     * @return The rectangle, in pixels.
+     */
+    sf::FloatRect getVisibleArea() const;
+
+    const sf::View& getView() const { return m_view; }
+    float getPixelScale() const { return 1.f / m_zoom; } // Screen pixels per world pixel
+};
@@ -1,290 +1,400 @@
-#include "circle.hpp"
-
-std::random_device rd;
-std::mt19937 gen(rd());
-
-static constexpr float TARGET_ANGULAR_ACCELERATION = 30.f;  // Acclration angulaire souhaite (en rad/s)
-static constexpr float TARGET_ACCELERATION = 100.f;  // Acclration souhaite (en m/s)
-
-static constexpr float MAX_ACCELERATION_BOT = 10.0f;  // Valeur de l'acclration maximale pour le bot
-static constexpr float MAX_ANGULAR_SPEED_BOT = 10.0f;  // Vitesse angulaire maximale pour le bot
-static constexpr float MAX_SPEED_BOT = 20.0f;  // Vitesse maximale du bot
-static constexpr float M_PI = 3.14159265358979323846;
-
-int Circle::m_circleID = 0;
-
-Circle::Circle(b2World& world, float radius)
-    : Circle(world, radius, sf::Vector2f(
-        std::uniform_int_distribution<>(1, WINDOW_WIDTH - 1)(gen),
-        std::uniform_int_distribution<>(1, WINDOW_HEIGHT - 1)(gen)
-    )) {
-}
-
-/**
- * @brief Constructs a Circle object.
- * @param world The Box2D world in which the circle exists.
- * @param radius The radius of the circle.
- * @param positionPixels The initial position of the circle in pixels.
- */
-Circle::Circle(b2World& world, float radius, sf::Vector2f positionPixels)
-    : m_radius(radius)
-{
-    b2BodyDef bodyDef; 
-    bodyDef.type = b2_dynamicBody;
-    bodyDef.position.Set(positionPixels.x / SCALE, positionPixels.y / SCALE);
-    m_body = world.CreateBody(&bodyDef);
-
-    b2CircleShape shape;
-    shape.m_radius = radius / SCALE;
-
-    b2FixtureDef fixtureDef;
-    fixtureDef.shape = &shape;
-    fixtureDef.density = 1000.f;
-    fixtureDef.friction = 0.05f;
-    m_body->CreateFixture(&fixtureDef);
-
-    m_body->SetAngularDamping(5.f);
-    m_body->SetLinearDamping(5.f);
-
-    m_mass = m_body->GetMass();
-    m_inertiaMoment = m_body->GetInertia();
-
-    m_circle.setRadius(radius);
-    m_circle.setFillColor(sf::Color::Green);
-    m_circle.setOrigin(radius, radius);
-
-    m_instanceID = m_circleID++;
-}
-
-/**
- * @brief Applies control inputs to the circle.
- */
-void Circle::applyControl() {
-    b2Vec2 direction;
-    b2Vec2 force;
-    float torque;
-    b2Vec2 velocity;
-
-    torque = TARGET_ANGULAR_ACCELERATION * m_inertiaMoment;
-    if(sf::Keyboard::isKeyPressed(sf::Keyboard::Right))
-        m_body->ApplyTorque(torque, true);
-    if(sf::Keyboard::isKeyPressed(sf::Keyboard::Left))
-        m_body->ApplyTorque(-torque, true);
-
-    //// Apply rotation, depends on mass
-    //if(sf::Keyboard::isKeyPressed(sf::Keyboard::Right))
-    //    m_body->ApplyTorque(m_torque, true);
-    //if(sf::Keyboard::isKeyPressed(sf::Keyboard::Left))
-    //    m_body->ApplyTorque(-m_torque, true);
-
-    //// Apply acceleration, depends on mass
-    m_angle = m_body->GetAngle();
-    direction = { cos(m_angle), sin(m_angle) };
-    //force = m_magnitude * direction;
-    //if(sf::Keyboard::isKeyPressed(sf::Keyboard::Up))
-    //    m_body->ApplyForceToCenter(force, true);;
-    //if(sf::Keyboard::isKeyPressed(sf::Keyboard::Down))
-    //    m_body->ApplyForceToCenter(-force, true);;
-
-
-    velocity = m_body->GetLinearVelocity();
-    force = TARGET_ACCELERATION * m_mass * direction;
-    if(sf::Keyboard::isKeyPressed(sf::Keyboard::Up)) {
-        m_body->ApplyForceToCenter(force, true);
-    }
-    if(sf::Keyboard::isKeyPressed(sf::Keyboard::Down)) {
-        m_body->ApplyForceToCenter(-force, true);
-    }
-
-}
-
-void Circle::applyControl(std::bitset<4> directions) { // bool goUp, bool goDown, bool goRight, bool goLeft
-    b2Vec2 orientation;
-    b2Vec2 force;
-    float torque;
-    b2Vec2 velocity;
-    enum Direction { Up = 0, Down, Right, Left };
-
-    torque = TARGET_ANGULAR_ACCELERATION * m_inertiaMoment;
-    if(directions[Right])
-        m_body->ApplyTorque(torque, true);
-    if(directions[Left])
-        m_body->ApplyTorque(-torque, true);
-
-    m_angle = m_body->GetAngle();
-    orientation = { cos(m_angle), sin(m_angle) };
-    velocity = m_body->GetLinearVelocity();
-    force = TARGET_ACCELERATION * m_mass * orientation;
-    if(directions[Up]) {
-        m_body->ApplyForceToCenter(force, true);
-    }
-    if(directions[Down]) {
-        m_body->ApplyForceToCenter(-force, true);
-    }
-
-}
-
-//std::bitset<4> Circle::botControl(sf::RenderWindow& window) {
-//    std::bitset<4> directions;
-//    enum Direction { Up = 0, Down, Right, Left };
-//
-//    // Vecteur vers la cible en pixels
-//    sf::Vector2f posPixels = m_circle.getPosition();
-//    sf::Vector2i mousePosPixels = sf::Mouse::getPosition(window);
-//    sf::Vector2f delta = sf::Vector2f(mousePosPixels) - posPixels;
-//
-//    float angleToTarget = std::atan2(delta.y, delta.x);
-//    float currentAngle = m_body->GetAngle();
-//
-//    float angleDiff = angleToTarget - currentAngle;
-//
-//    // Normaliser l'angle entre -pi et pi
-//    while(angleDiff > 3.14159265f) angleDiff -= 2 * 3.14159265f;
-//    while(angleDiff < -3.14159265f) angleDiff += 2 * 3.14159265f;
-//
-//    // Dcide de tourner  droite ou  gauche
-//    if(angleDiff > 0.1f)
-//        directions[Right] = true;
-//    else if(angleDiff < -0.1f)
-//        directions[Left] = true;
-//
-//    // Si on est presque align, avancer
-//    if(std::abs(angleDiff) < 0.3f)
-//        directions[Up] = true;
-//
-//    return directions;
-//}
-
-inline float degToRad(float deg) {
-    return deg * M_PI / 180.0f;
-}
-
-std::bitset<4> Circle::botControl(sf::RenderWindow& window) {
-    // Pas du tout optimis, juste une traduction bete et mechante de mon code python
-    std::bitset<4> directions;
-    enum Direction { Up = 0, Down, Right, Left };
-
-    // Position du bot (cercle)
-    b2Vec2 pos = m_body->GetPosition();
-    sf::Vector2f botPos(pos.x * SCALE, pos.y * SCALE);
-
-    // Position cible (souris)
-    sf::Vector2i mousePosPixels = sf::Mouse::getPosition(window);
-    sf::Vector2f targetPos = window.mapPixelToCoords(mousePosPixels);
-
-    // Vecteur direction vers la cible
-    sf::Vector2f delta = targetPos - botPos;
-
-    // Angle vers la cible
-    float targetAngle = std::atan2(delta.y, delta.x);
-    float currentAngle = m_body->GetAngle();
-    float angleDiff = targetAngle - currentAngle;
-
-    while(angleDiff > M_PI) angleDiff -= 2 * M_PI;
-    while(angleDiff < -M_PI) angleDiff += 2 * M_PI;
-
-    float speed = m_body->GetLinearVelocity().Length();
-    float acceleration = MAX_ACCELERATION_BOT;
-    float movingAngle = 0;
-
-    float threshold = -180.0f / MAX_ANGULAR_SPEED_BOT / 2.0f;
-
-    if(speed > threshold) {
-        if(std::abs(angleDiff) > degToRad(MAX_ANGULAR_SPEED_BOT)) {
-            int nbRotationBefore90 = std::floor((std::abs(angleDiff) - M_PI / 2.0f) / degToRad(MAX_ANGULAR_SPEED_BOT));
-            if(nbRotationBefore90 > 1 && speed > MAX_SPEED_BOT - nbRotationBefore90) {
-                acceleration = -MAX_ACCELERATION_BOT / 2.0f;
-            }
-            else if(nbRotationBefore90 == 1 && speed > MAX_SPEED_BOT - nbRotationBefore90) {
-                acceleration = 0;
-            }
-            movingAngle = degToRad(MAX_ANGULAR_SPEED_BOT) * std::copysign(1.0f, angleDiff);
-        }
-        else if(std::abs(angleDiff) > 0) {
-            movingAngle = angleDiff;
-        }
-    }
-    else {
-        float deltaToPi = std::abs(M_PI - std::abs(angleDiff));
-        if(deltaToPi > degToRad(MAX_ANGULAR_SPEED_BOT)) {
-            movingAngle = -degToRad(MAX_ANGULAR_SPEED_BOT) * std::copysign(1.0f, angleDiff);
-        }
-        else if(deltaToPi > 0) {
-            movingAngle = -deltaToPi * std::copysign(1.0f, angleDiff);
-        }
-    }
-
-    // Convertit le mouvement en directions
-    if(std::abs(2 * movingAngle) > 0.01f) {
-        directions[Right] = (2 * movingAngle > 0);
-        directions[Left] = (2 * movingAngle < 0);
-    }
-
-    if(acceleration > 0.01f) directions[Up] = true;
-    else if(acceleration < -0.01f) directions[Down] = true;
-
-    return directions;
-}
-
-/**
- * @brief Updates the list of visible circles using raycasting.
- * @param world The Box2D world.
- * @param allCircles The list of all circles in the world.
- */
-void Circle::updateVision(b2World& world, const std::vector<Circle*>& allCircles) {
-    m_visibleCircles.clear();
-    b2Vec2 pos = m_body->GetPosition();
-
-    for(Circle* other : allCircles) {
-        if(other == this) continue;
-
-        b2Vec2 otherPos = other->m_body->GetPosition();
-        b2RayCastInput input;
-        input.p1 = pos;
-        input.p2 = otherPos;
-        input.maxFraction = 1.0f;
-
-        b2RayCastOutput output;
-        for(b2Body* b = world.GetBodyList(); b; b = b->GetNext()) {
-            for(b2Fixture* f = b->GetFixtureList(); f; f = f->GetNext()) {
-                if(!f->RayCast(&output, input, 0)) continue;
-                if(output.fraction < input.maxFraction) {
-                    input.maxFraction = output.fraction;
-                }
-            }
-        }
-
-        if(input.maxFraction == 1.0f) {
-            m_visibleCircles.push_back(other);
-        }
-    }
-}
-
-/**
- * @brief Draws the circle in the SFML render window.
- * @param window The SFML render window.
- */
-void Circle::draw(sf::RenderWindow& window)
-{
-    b2Vec2 pos = m_body->GetPosition();
-    m_circle.setPosition(pos.x * SCALE, pos.y * SCALE);
-    window.draw(m_circle);
-    drawDirectionLine(window);
-}
-
-/**
- * @brief Draws the direction line of the circle.
- * @param window The SFML render window.
- */
-void Circle::drawDirectionLine(sf::RenderWindow& window) {
-    float angle = m_body->GetAngle();
-    float lineLength = m_radius * 1.2f;
-    sf::Vector2f center = m_circle.getPosition();
-    sf::Vector2f direction(cos(angle) * lineLength, sin(angle) * lineLength);
-
-    sf::Vertex line[] = {
-        sf::Vertex(center, sf::Color::Red),
-        sf::Vertex(center + direction, sf::Color::Red)
-    };
-    window.draw(line, 2, sf::Lines);
-}
+#include "circle.hpp"
+
+#include <algorithm>
+
+static constexpr float TARGET_ANGULAR_ACCELERATION = 30.f;  // Accélération angulaire souhaitée (en rad/s²)
+static constexpr float TARGET_ACCELERATION = 100.f;  // Accélération souhaitée (en m/s²)
+
+static constexpr float MAX_HEALTH = 100.f;
+
+static const std::array<sf::Color, 4> TEAM_COLORS = { sf::Color::Green, sf::Color::Blue, sf::Color::Yellow, sf::Color::Magenta };
+
+/**
+ * @brief Draws a random position in the arena.
+ * @param arenaSize The size of the arena, in pixels.
+ * @param rng The random generator of the simulation.
+ * @return The position in pixels.
+ */
+static sf::Vector2f randomPosition(const sf::Vector2f& arenaSize, std::mt19937& rng) {
+    // Deux instructions : l'ordre d'évaluation des arguments d'un appel n'est pas garanti, x doit être tiré avant y
+    float x = (float)std::uniform_int_distribution<>(1, (int)arenaSize.x - 1)(rng);
+    float y = (float)std::uniform_int_distribution<>(1, (int)arenaSize.y - 1)(rng);
+    return sf::Vector2f(x, y);
+}
+
+/**
+ * @brief Constructs a Circle object at a random position in the arena.
+ * @param store The agent storage of the simulation, where the circle gets its ID.
+ * @param world The Box2D world in which the circle exists.
+ * @param radius The radius of the circle.
+ * @param team The team of the circle.
+ * @param arenaSize The size of the arena, in pixels.
+ * @param rng The random generator of the simulation.
+ */
+Circle::Circle(AgentStore& store, b2World& world, float radius, int team, const sf::Vector2f& arenaSize, std::mt19937& rng)
+    : Circle(store, world, radius, team, randomPosition(arenaSize, rng)) {
+}
+
+/**
+ * @brief Constructs a Circle object.
+ * @param store The agent storage of the simulation, where the circle gets its ID.
+ * @param world The Box2D world in which the circle exists.
+ * @param radius The radius of the circle.
+ * @param team The team of the circle.
+ * @param positionPixels The initial position of the circle in pixels.
+ */
+Circle::Circle(AgentStore& store, b2World& world, float radius, int team, sf::Vector2f positionPixels)
+    : m_store(&store), m_instanceID(store.size())
+{
+    b2BodyDef bodyDef; 
+    bodyDef.type = b2_dynamicBody;
+    bodyDef.position.Set(positionPixels.x / SCALE, positionPixels.y / SCALE);
+    bodyDef.userData.pointer = (uintptr_t)m_instanceID + 1; // 0 est réservé aux corps qui ne sont pas des cercles
+    b2Body* body = world.CreateBody(&bodyDef);
+
+    b2CircleShape shape;
+    shape.m_radius = radius / SCALE;
+
+    b2FixtureDef fixtureDef;
+    fixtureDef.shape = &shape;
+    fixtureDef.density = 1000.f;
+    fixtureDef.friction = 0.05f;
+    body->CreateFixture(&fixtureDef);
+
+    body->SetAngularDamping(5.f);
+    body->SetLinearDamping(5.f);
+
+    store.add(body, radius, team, MAX_HEALTH); // Après la fixture : masse et inertie sont connues
+}
+
+/**
+ * @brief Sets the collision filter of the body fixture, see CollisionFilter.
+ * @param filter The filter.
+ */
+void Circle::setCollisionFilter(const b2Filter& filter) {
+    for(b2Fixture* fixture = m_store->bodies[m_instanceID]->GetFixtureList(); fixture; fixture = fixture->GetNext()) {
+        if(!fixture->IsSensor())
+            fixture->SetFilterData(filter);
+    }
+}
+
+/**
+ * @brief Adds a sensor fixture around the body, whose contacts tell which enemies are within the aggro radius.
+ * @param radius The aggro radius, in pixels, measured from the centre of the circle.
+ * @param filter The filter of the sensor, see CollisionFilter::makeAggroFilter().
+ */
+void Circle::addAggroSensor(float radius, const b2Filter& filter) {
+    b2CircleShape shape;
+    shape.m_radius = radius / SCALE;
+
+    b2FixtureDef fixtureDef;
+    fixtureDef.shape = &shape;
+    fixtureDef.isSensor = true; // Densité nulle : la masse ne change pas
+    fixtureDef.filter = filter;
+    m_store->bodies[m_instanceID]->CreateFixture(&fixtureDef);
+}
+
+/**
+ * @brief Gets the position of the circle.
+ * @return The body position, in pixels.
+ */
+sf::Vector2f Circle::getPosition() const {
+    return sf::Vector2f(m_store->positionX[m_instanceID] * SCALE, m_store->positionY[m_instanceID] * SCALE);
+}
+
+/**
+ * @brief Applies control inputs to the circle.
+ * @param directions The controls to apply, indexed by Direction.
+ */
+void Circle::applyControl(std::bitset<4> directions) { // bool goUp, bool goDown, bool goRight, bool goLeft
+    AgentStore& store = *m_store;
+    int id = m_instanceID;
+    b2Body* body = store.bodies[id];
+    b2Vec2 orientation;
+    b2Vec2 force;
+    float torque;
+
+    torque = TARGET_ANGULAR_ACCELERATION * store.inertia[id];
+    if(directions[Right])
+        body->ApplyTorque(torque, true);
+    if(directions[Left])
+        body->ApplyTorque(-torque, true);
+
+    orientation = { store.rotationCos[id], store.rotationSin[id] }; // cos/sin de l'angle, copiés de la rotation du corps
+    force = TARGET_ACCELERATION * store.mass[id] * orientation;
+    if(directions[Up]) {
+        body->ApplyForceToCenter(force, true);
+    }
+    if(directions[Down]) {
+        body->ApplyForceToCenter(-force, true);
+    }
+
+}
+
+//std::bitset<4> Circle::botControl(sf::RenderWindow& window) {
+//    std::bitset<4> directions;
+//    enum Direction { Up = 0, Down, Right, Left };
+//
+//    // Vecteur vers la cible en pixels
+//    sf::Vector2f posPixels = m_circle.getPosition();
+//    sf::Vector2i mousePosPixels = sf::Mouse::getPosition(window);
+//    sf::Vector2f delta = sf::Vector2f(mousePosPixels) - posPixels;
+//
+//    float angleToTarget = std::atan2(delta.y, delta.x);
+//    float currentAngle = store.angle[id];
+//
+//    float angleDiff = angleToTarget - currentAngle;
+//
+//    // Normaliser l'angle entre -pi et pi
+//    while(angleDiff > 3.14159265f) angleDiff -= 2 * 3.14159265f;
+//    while(angleDiff < -3.14159265f) angleDiff += 2 * 3.14159265f;
+//
+//    // Décide de tourner à droite ou à gauche
+//    if(angleDiff > 0.1f)
+//        directions[Right] = true;
+//    else if(angleDiff < -0.1f)
+//        directions[Left] = true;
+//
+//    // Si on est presque aligné, avancer
+//    if(std::abs(angleDiff) < 0.3f)
+//        directions[Up] = true;
+//
+//    return directions;
+//}
+
+/**
+ * @brief Computes the bot controls needed to steer toward a target.
+ *
+ * Reference version for one circle: the simulation uses the batched Steering::computeBotControls().
+ * @param targetPixels The target position in pixels.
+ * @return The controls, indexed by Direction.
+ */
+std::bitset<4> Circle::botControl(sf::Vector2f targetPixels) const {
+    // Pas du tout optimisé, juste une traduction bete et mechante de mon code python
+    std::bitset<4> directions;
+
+    const AgentStore& store = *m_store;
+    int id = m_instanceID;
+
+    // Position du bot (cercle)
+    sf::Vector2f botPos(store.positionX[id] * SCALE, store.positionY[id] * SCALE);
+
+    // Vecteur direction vers la cible
+    sf::Vector2f delta = targetPixels - botPos;
+
+    // Angle vers la cible
+    float targetAngle = std::atan2(delta.y, delta.x);
+    float currentAngle = store.angle[id];
+    float angleDiff = targetAngle - currentAngle;
+
+    while(angleDiff > Utils::PI) angleDiff -= 2 * Utils::PI;
+    while(angleDiff < -Utils::PI) angleDiff += 2 * Utils::PI;
+
+    float speed = b2Vec2(store.velocityX[id], store.velocityY[id]).Length();
+    float acceleration = MAX_ACCELERATION_BOT;
+    float movingAngle = 0;
+
+    float threshold = -180.0f / MAX_ANGULAR_SPEED_BOT / 2.0f;
+
+    if(speed > threshold) {
+        if(std::abs(angleDiff) > Utils::deg2Rad(MAX_ANGULAR_SPEED_BOT)) {
+            int nbRotationBefore90 = std::floor((std::abs(angleDiff) - Utils::PI / 2.0f) / Utils::deg2Rad(MAX_ANGULAR_SPEED_BOT));
+            if(nbRotationBefore90 > 1 && speed > MAX_SPEED_BOT - nbRotationBefore90) {
+                acceleration = -MAX_ACCELERATION_BOT / 2.0f;
+            }
+            else if(nbRotationBefore90 == 1 && speed > MAX_SPEED_BOT - nbRotationBefore90) {
+                acceleration = 0;
+            }
+            movingAngle = Utils::deg2Rad(MAX_ANGULAR_SPEED_BOT) * std::copysign(1.0f, angleDiff);
+        }
+        else if(std::abs(angleDiff) > 0) {
+            movingAngle = angleDiff;
+        }
+    }
+    else {
+        float deltaToPi = std::abs(Utils::PI - std::abs(angleDiff));
+        if(deltaToPi > Utils::deg2Rad(MAX_ANGULAR_SPEED_BOT)) {
+            movingAngle = -Utils::deg2Rad(MAX_ANGULAR_SPEED_BOT) * std::copysign(1.0f, angleDiff);
+        }
+        else if(deltaToPi > 0) {
+            movingAngle = -deltaToPi * std::copysign(1.0f, angleDiff);
+        }
+    }
+
+    // Convertit le mouvement en directions
+    if(std::abs(2 * movingAngle) > 0.01f) {
+        directions[Right] = (2 * movingAngle > 0);
+        directions[Left] = (2 * movingAngle < 0);
+    }
+
+    if(acceleration > 0.01f) directions[Up] = true;
+    else if(acceleration < -0.01f) directions[Down] = true;
+
+    return directions;
+}
+
+/**
+ * @class VisionRayCallback
+ * @brief Keeps the closest solid fixture hit by a vision ray.
+ */
+class VisionRayCallback : public b2RayCastCallback {
+public:
+    const b2Body* m_closestBody{ nullptr };
+
+    float ReportFixture(b2Fixture* fixture, const b2Vec2&, const b2Vec2&, float fraction) override {
+        if(fixture->IsSensor())
+            return -1.f; // Ignore le fixture et continue
+        m_closestBody = fixture->GetBody();
+        return fraction; // Raccourcit le rayon jusqu'à ce point
+    }
+};
+
+/**
+ * @class VisionQueryCallback
+ * @brief Rejects the circles out of range or out of the vision cone, and casts a ray to the others.
+ *
+ * The visible circles go into a fixed number of slots: once they are full, a circle only gets a ray
+ * if it is nearer than the farthest one kept, and then replaces it.
+ */
+class VisionQueryCallback : public b2QueryCallback {
+public:
+    const b2World* m_world;
+    const b2Body* m_self;
+    int* m_visibleCircles; // AgentStore::MAX_VISIBLE_AGENTS slots
+    int m_visibleCount{ 0 };
+    float m_distancesSquared[AgentStore::MAX_VISIBLE_AGENTS]; // m², of each slot
+    b2Vec2 m_position;
+    b2Vec2 m_forward;
+    float m_rangeSquared; // m²
+    float m_cosHalfFieldOfView;
+    int m_maxRays; // -1 for no limit
+    int m_rayCastCount{ 0 };
+
+    bool ReportFixture(b2Fixture* fixture) override {
+        const b2Body* body = fixture->GetBody();
+        int id = Circle::getCircleID(body);
+        if(id < 0 || body == m_self || fixture->IsSensor())
+            return true;
+
+        b2Vec2 otherPos = body->GetPosition();
+        b2Vec2 delta = otherPos - m_position;
+        float distanceSquared = delta.LengthSquared();
+        if(distanceSquared > m_rangeSquared)
+            return true;
+        // Dans le cône si cos(angle) >= cos(fov / 2), sans racine ni division : dot >= cos * |delta|
+        float dot = b2Dot(m_forward, delta);
+        if(dot < 0 && m_cosHalfFieldOfView >= 0)
+            return true;
+        if(dot * std::abs(dot) < m_cosHalfFieldOfView * std::abs(m_cosHalfFieldOfView) * distanceSquared)
+            return true;
+
+        int slot = m_visibleCount;
+        if(slot == AgentStore::MAX_VISIBLE_AGENTS) {
+            slot = (int)(std::max_element(m_distancesSquared, m_distancesSquared + slot) - m_distancesSquared);
+            if(distanceSquared >= m_distancesSquared[slot])
+                return true;
+        }
+
+        if(m_rayCastCount == m_maxRays)
+            return false; // Plus de rayons pour ce tick : on arrête la requête
+        VisionRayCallback ray;
+        m_world->RayCast(&ray, m_position, otherPos);
+        m_rayCastCount++;
+        if(ray.m_closestBody == body) {
+            m_visibleCircles[slot] = id;
+            m_distancesSquared[slot] = distanceSquared;
+            m_visibleCount = std::max(m_visibleCount, slot + 1);
+        }
+        return true;
+    }
+};
+
+/**
+ * @brief Updates the list of visible circles using raycasting.
+ *
+ * Only the circles found by a broadphase query around the circle, within range and inside the
+ * vision cone, get a ray. A circle is visible when it is the first fixture hit by its ray.
+ * @param world The Box2D world.
+ * @param vision The vision limits.
+ * @param arena The frame arena of the calling thread, which holds the list until the next tick.
+ * @return The number of rays cast.
+ */
+int Circle::updateVision(const b2World& world, const VisionSettings& vision, FrameArena& arena) {
+    AgentStore& store = *m_store;
+    int id = m_instanceID;
+
+    b2Vec2 position(store.positionX[id], store.positionY[id]);
+    float range = vision.range / SCALE;
+
+    VisionQueryCallback query;
+    query.m_world = &world;
+    query.m_self = store.bodies[id];
+    query.m_visibleCircles = arena.allocate<int>(AgentStore::MAX_VISIBLE_AGENTS);
+    query.m_position = position;
+    query.m_forward = b2Vec2(store.rotationCos[id], store.rotationSin[id]);
+    query.m_rangeSquared = range * range;
+    query.m_cosHalfFieldOfView = Utils::fastCos(vision.fieldOfView / 2);
+    query.m_maxRays = vision.maxRays > 0 ? vision.maxRays : -1;
+
+    b2AABB area;
+    area.lowerBound = position - b2Vec2(range, range);
+    area.upperBound = position + b2Vec2(range, range);
+    world.QueryAABB(&query, area);
+    store.visibleAgents[id] = std::span<const int>(query.m_visibleCircles, query.m_visibleCount);
+    return query.m_rayCastCount;
+}
+
+/**
+ * @brief Copies the dynamic state of the circle and of its body.
+ * @param state Receives the state.
+ */
+void Circle::saveState(CircleState& state) const {
+    const AgentStore& store = *m_store;
+    int id = m_instanceID;
+    const b2Body* body = store.bodies[id];
+    state.position = body->GetPosition();
+    state.bodyAngle = body->GetAngle();
+    state.linearVelocity = body->GetLinearVelocity();
+    state.angularVelocity = body->GetAngularVelocity();
+    state.previousPosition.Set(store.previousX[id], store.previousY[id]);
+    state.previousAngle = store.previousAngle[id];
+    state.health = store.health[id];
+    state.controls = store.controls[id];
+    state.awake = body->IsAwake();
+    state.aiActive = store.aiActive[id] != 0;
+    state.decisionDue = store.decisionDue[id] != 0;
+    state.aggroTarget = store.aggroTarget[id];
+    state.aggroCount = store.aggroCount[id];
+}
+
+/**
+ * @brief Puts the circle and its body back in a state saved by saveState().
+ * @param state The state to restore.
+ */
+void Circle::restoreState(const CircleState& state) {
+    AgentStore& store = *m_store;
+    int id = m_instanceID;
+    b2Body* body = store.bodies[id];
+    body->SetTransform(state.position, state.bodyAngle);
+    body->SetLinearVelocity(state.linearVelocity);
+    body->SetAngularVelocity(state.angularVelocity);
+    body->SetAwake(state.awake); // En dernier : une vitesse non nulle réveille le corps
+    store.syncFromBody(id);
+    store.previousX[id] = state.previousPosition.x;
+    store.previousY[id] = state.previousPosition.y;
+    store.previousAngle[id] = state.previousAngle;
+    store.health[id] = state.health;
+    store.controls[id] = state.controls;
+    store.aiActive[id] = state.aiActive;
+    store.decisionDue[id] = state.decisionDue;
+    store.aggroTarget[id] = state.aggroTarget;
+    store.aggroCount[id] = state.aggroCount;
+}
+
+/**
+ * @brief Gets the color circles of a team are drawn with.
+ * @param team The team.
+ */
+sf::Color Circle::getTeamColor(int team) {
+    return TEAM_COLORS[team % TEAM_COLORS.size()];
+}
@@ -1,70 +1,163 @@
-#pragma once
-
-#include <SFML/Graphics.hpp>
-#include <box2d/box2d.h>
-#include <random>
-#include <bitset> // Gestion de bits
-#include <cmath>
-
-#include "constants.hpp"
-#include "utils.hpp"
-
-/**
- * @class Circle
- * @brief Represents a circle in a Box2D world with SFML rendering.
- */
-class Circle {
-private:
-    float m_torque{ 8000.f };
-    float m_angle{ 0 };
-    float m_magnitude{ 60000.f };
-    float m_radius;
-    b2Body* m_body;
-    float m_mass;
-    float m_inertiaMoment;
-    sf::CircleShape m_circle;
-    std::vector<Circle*> m_visibleCircles; // List of other circles in the field of view
-    static int m_circleID; // Static member to keep track of the ID across all 
-
-    /**
-     * @brief Draws the direction line of the circle.
-     * @param window The SFML render window.
-     */
-    void drawDirectionLine(sf::RenderWindow& window);
-
-public:
-    int m_instanceID; // Unique ID for each Circle instance
-
-    Circle(b2World& world, float radius);
-
-    /**
-     * @brief Constructs a Circle object.
-     * @param world The Box2D world in which the circle exists.
-     * @param radius The radius of the circle.
-     * @param positionPixels The initial position of the circle in pixels.
-     */
-    Circle(b2World& world, float radius, sf::Vector2f positionPixels);
-
-    /**
-     * @brief Applies control inputs to the circle.
-     */
-    void applyControl();
-    void applyControl(std::bitset<4> directions);
-
-    std::bitset<4> botControl(sf::RenderWindow& window);
-
-    /**
-     * @brief Updates the list of visible circles using raycasting.
-     * @param world The Box2D world.
-     * @param allCircles The list of all circles in the world.
-     */
-    void updateVision(b2World& world, const std::vector<Circle*>& allCircles);
-
-    /**
-     * @brief Draws the circle in the SFML render window.
-     * @param window The SFML render window.
-     */
-    void draw(sf::RenderWindow& window);
-
-};
-
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <box2d/box2d.h>
+#include <array>
+#include <random>
+#include <bitset> // Gestion de bits
+#include <cmath>
+#include <cstdint>
+#include <span>
+
+#include "agent_store.hpp"
+#include "constants.hpp"
+#include "frame_arena.hpp"
+#include "utils.hpp"
+
+/**
+ * @struct CircleState
+ * @brief Dynamic state of a circle and of its body, as stored in a simulation snapshot.
+ */
+struct CircleState {
+    b2Vec2 position;
+    float bodyAngle;
+    b2Vec2 linearVelocity;
+    float angularVelocity;
+    b2Vec2 previousPosition;
+    float previousAngle;
+    float health;
+    std::uint8_t controls;
+    bool awake;
+    bool aiActive;
+    bool decisionDue;
+    int aggroTarget;
+    std::uint16_t aggroCount;
+};
+
+/**
+ * @struct VisionSettings
+ * @brief Limits of what a circle can see.
+ */
+struct VisionSettings {
+    float range{ 300.f }; // Maximum distance between centres, in pixels
+    float fieldOfView{ 2.0943951f }; // Full angle of the vision cone around the heading, in radians (120°)
+    int maxRays{ 0 }; // Rays cast per circle and tick, the circles reported after that are not seen. 0 for no limit
+};
+
+/**
+ * @class Circle
+ * @brief Represents a circle in a Box2D world with SFML rendering.
+ *
+ * A Circle is a thin handle: its state lives in the AgentStore of its simulation, at index m_instanceID.
+ */
+class Circle {
+private:
+    AgentStore* m_store;
+
+public:
+    enum Direction { Up = 0, Down, Right, Left }; // Bit index of each control in std::bitset<4>
+
+    int m_instanceID; // Unique ID of the circle within its simulation, index in the AgentStore
+
+    /**
+     * @brief Constructs a Circle object at a random position in the arena.
+     * @param store The agent storage of the simulation, where the circle gets its ID.
+     * @param world The Box2D world in which the circle exists.
+     * @param radius The radius of the circle.
+     * @param team The team of the circle.
+     * @param arenaSize The size of the arena, in pixels.
+     * @param rng The random generator of the simulation.
+     */
+    Circle(AgentStore& store, b2World& world, float radius, int team, const sf::Vector2f& arenaSize, std::mt19937& rng);
+
+    /**
+     * @brief Constructs a Circle object.
+     * @param store The agent storage of the simulation, where the circle gets its ID.
+     * @param world The Box2D world in which the circle exists.
+     * @param radius The radius of the circle.
+     * @param team The team of the circle.
+     * @param positionPixels The initial position of the circle in pixels.
+     */
+    Circle(AgentStore& store, b2World& world, float radius, int team, sf::Vector2f positionPixels);
+
+    /**
+     * @brief Gets the position of the circle.
+     * @return The body position, in pixels.
+     */
+    sf::Vector2f getPosition() const;
+
+    int getTeam() const { return m_store->team[m_instanceID]; }
+    const b2Body* getBody() const { return m_store->bodies[m_instanceID]; }
+
+    /**
+     * @brief Applies control inputs to the circle.
+     * @param directions The controls to apply, indexed by Direction.
+     */
+    void applyControl(std::bitset<4> directions);
+
+    /**
+     * @brief Computes the bot controls needed to steer toward a target.
+     *
+     * Reference version for one circle: the simulation uses the batched Steering::computeBotControls().
+     * @param targetPixels The target position in pixels.
+     * @return The controls, indexed by Direction.
+     */
+    std::bitset<4> botControl(sf::Vector2f targetPixels) const;
+
+    /**
+     * @brief Sets the collision filter of the body fixture, see CollisionFilter.
+     * @param filter The filter.
+     */
+    void setCollisionFilter(const b2Filter& filter);
+
+    /**
+     * @brief Adds a sensor fixture around the body, whose contacts tell which enemies are within the aggro radius.
+     * @param radius The aggro radius, in pixels, measured from the centre of the circle.
+     * @param filter The filter of the sensor, see CollisionFilter::makeAggroFilter().
+     */
+    void addAggroSensor(float radius, const b2Filter& filter);
+
+    /**
+     * @brief Updates the list of visible circles using raycasting.
+     *
+     * Only the circles found by a broadphase query around the circle, within range and inside the
+     * vision cone, get a ray. A circle is visible when it is the first fixture hit by its ray.
+     * @param world The Box2D world.
+     * @param vision The vision limits.
+     * @param arena The frame arena of the calling thread, which holds the list until the next tick.
+     * @return The number of rays cast.
+     */
+    int updateVision(const b2World& world, const VisionSettings& vision, FrameArena& arena);
+
+    /**
+     * @brief Gets the IDs of the circles seen by the last updateVision(), at most AgentStore::MAX_VISIBLE_AGENTS.
+     * Only valid during the tick that computed them.
+     */
+    std::span<const int> getVisibleCircles() const { return m_store->getVisibleAgents(m_instanceID); }
+
+    /**
+     * @brief Gets the ID of the circle owning a body.
+     * @param body The body.
+     * @return The circle ID, -1 if the body is not a circle (e.g. a wall).
+     */
+    static int getCircleID(const b2Body* body) { return (int)body->GetUserData().pointer - 1; }
+
+    /**
+     * @brief Copies the dynamic state of the circle and of its body.
+     * @param state Receives the state.
+     */
+    void saveState(CircleState& state) const;
+
+    /**
+     * @brief Puts the circle and its body back in a state saved by saveState().
+     * @param state The state to restore.
+     */
+    void restoreState(const CircleState& state);
+
+    /**
+     * @brief Gets the color circles of a team are drawn with.
+     * @param team The team.
+     */
+    static sf::Color getTeamColor(int team);
+
+};
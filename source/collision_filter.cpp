@@ -0,0 +1,53 @@
+#include "collision_filter.hpp"
+
+#include <cassert>
+
+#include "circle.hpp"
+
+/**
+ * @brief Gets the category bits of every team.
+ */
+static std::uint16_t getAllTeamsCategories(int teamCount) {
+    assert(teamCount <= CollisionFilter::MAX_TEAMS);
+    std::uint16_t categories = 0;
+    for(int team = 0; team < teamCount; team++)
+        categories |= CollisionFilter::getTeamCategory(team);
+    return categories;
+}
+
+/**
+ * @brief Builds the filter of the body fixture of a circle.
+ * @param team The team of the circle.
+ * @param teamCount The number of teams, at most MAX_TEAMS.
+ * @param teammatesCollide If false, the circles of a team pass through each other.
+ * @return The filter.
+ */
+b2Filter CollisionFilter::makeBodyFilter(int team, int teamCount, bool teammatesCollide) {
+    b2Filter filter;
+    filter.categoryBits = getTeamCategory(team);
+    filter.maskBits = WALL_CATEGORY | AGGRO_CATEGORY | getAllTeamsCategories(teamCount);
+    if(!teammatesCollide)
+        filter.maskBits &= (std::uint16_t)~getTeamCategory(team);
+    return filter;
+}
+
+/**
+ * @brief Builds the filter of the aggro sensor of a circle.
+ * @param team The team of the circle.
+ * @param teamCount The number of teams, at most MAX_TEAMS.
+ * @return The filter.
+ */
+b2Filter CollisionFilter::makeAggroFilter(int team, int teamCount) {
+    b2Filter filter;
+    filter.categoryBits = AGGRO_CATEGORY;
+    filter.maskBits = getAllTeamsCategories(teamCount) & (std::uint16_t)~getTeamCategory(team);
+    return filter;
+}
+
+bool TeamContactFilter::ShouldCollide(b2Fixture* fixtureA, b2Fixture* fixtureB) {
+    if(!b2ContactFilter::ShouldCollide(fixtureA, fixtureB)) // Bits et groupes, comme sans filtre
+        return false;
+    int idA = Circle::getCircleID(fixtureA->GetBody());
+    int idB = Circle::getCircleID(fixtureB->GetBody());
+    return (idA < 0 || m_agents->health[idA] > 0.f) && (idB < 0 || m_agents->health[idB] > 0.f);
+}
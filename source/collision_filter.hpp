@@ -0,0 +1,68 @@
+#pragma once
+
+#include <box2d/box2d.h>
+#include <cstdint>
+
+#include "agent_store.hpp"
+
+/**
+ * @class CollisionFilter
+ * @brief Category and mask bits of the fixtures, so that Box2D drops the unwanted pairs in the broadphase.
+ *
+ * Bit 0 is the wall category (the b2Filter default, walls keep it), bits 1 to MAX_TEAMS are one
+ * per team, and the last bit is the aggro sensors. A pair of fixtures only reaches the
+ * narrow phase when the category of each one is in the mask of the other:
+ * - circle bodies collide with the walls, with the enemies and, if enabled, with their teammates;
+ * - aggro sensors only overlap enemy bodies: no walls, no teammates, no other sensors.
+ */
+class CollisionFilter {
+public:
+    static constexpr std::uint16_t WALL_CATEGORY = 0x0001;
+    static constexpr std::uint16_t AGGRO_CATEGORY = 0x8000;
+    static constexpr int MAX_TEAMS = 14; // Bits left between the walls and the sensors
+
+    /**
+     * @brief Gets the category bit of a team.
+     * @param team The team, in [0, MAX_TEAMS).
+     */
+    static std::uint16_t getTeamCategory(int team) { return (std::uint16_t)(0x0002 << team); }
+
+    /**
+     * @brief Builds the filter of the body fixture of a circle.
+     * @param team The team of the circle.
+     * @param teamCount The number of teams, at most MAX_TEAMS.
+     * @param teammatesCollide If false, the circles of a team pass through each other.
+     * @return The filter.
+     */
+    static b2Filter makeBodyFilter(int team, int teamCount, bool teammatesCollide);
+
+    /**
+     * @brief Builds the filter of the aggro sensor of a circle.
+     * @param team The team of the circle.
+     * @param teamCount The number of teams, at most MAX_TEAMS.
+     * @return The filter.
+     */
+    static b2Filter makeAggroFilter(int team, int teamCount);
+};
+
+/**
+ * @class TeamContactFilter
+ * @brief Optional contact filter of the world: the category and mask bits, plus dead circles (no health
+ * left) that no longer collide with anything.
+ *
+ * Box2D only asks when a pair starts overlapping, so the fixtures of a circle must be refiltered
+ * (b2Fixture::Refilter()) when it dies.
+ */
+class TeamContactFilter : public b2ContactFilter {
+private:
+    const AgentStore* m_agents;
+
+public:
+    /**
+     * @brief Constructs the filter.
+     * @param agents The state of the circles, read for their health.
+     */
+    explicit TeamContactFilter(const AgentStore& agents) : m_agents(&agents) {}
+
+    bool ShouldCollide(b2Fixture* fixtureA, b2Fixture* fixtureB) override;
+};
@@ -1,22 +1,31 @@
-#pragma once
-
-// pixels (utiliss par SFML) en mtres (unit de Box2D), 30 pixels = 1 mtre
-constexpr float SCALE = 30.f;
-
-// Window
-constexpr float WINDOW_WIDTH = 1500.f;
-constexpr float WINDOW_HEIGHT = 900.f;
-
-
-
-
-
-
-
-
-
-
-/*
-constexpr est typ, vrifi  la compilation, scoped (limit  un namespace/classe), et respecte les rgles du C++.
-#define est un remplacement de texte brut sans type, ni porte, ni vrification par le compilateur.
+#pragma once
+
+// pixels (utilisés par SFML) en mètres (unité de Box2D), 30 pixels = 1 mètre
+constexpr float SCALE = 30.f;
+
+// Window
+constexpr float WINDOW_WIDTH = 1500.f;
+constexpr float WINDOW_HEIGHT = 900.f;
+
+// Simulation
+constexpr float TICK_RATE = 120.f; // Ticks physiques par seconde, indépendant du rendu
+constexpr int MAX_TICKS_PER_FRAME = 8; // Au-delà, on ralentit le jeu plutôt que de s'effondrer
+
+// Bots
+constexpr float MAX_ACCELERATION_BOT = 10.0f;  // Valeur de l'accélération maximale pour le bot
+constexpr float MAX_ANGULAR_SPEED_BOT = 10.0f;  // Vitesse angulaire maximale pour le bot (en degrés par décision)
+constexpr float MAX_SPEED_BOT = 20.0f;  // Vitesse maximale du bot
+
+
+
+
+
+
+
+
+
+
+/*
+constexpr est typé, vérifié à la compilation, scoped (limité à un namespace/classe), et respecte les règles du C++.
+#define est un remplacement de texte brut sans type, ni portée, ni vérification par le compilateur.
 */
\ No newline at end of file
@@ -0,0 +1,56 @@
+#include "contact_listener.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#include "circle.hpp"
+
+/**
+ * @brief Clears the events and prepares the buffer for the next world step.
+ * @param arena The frame arena of the thread stepping the world.
+ * @param capacity The number of events expected, the buffer grows in the arena beyond it.
+ */
+void ContactListener::beginStep(FrameArena& arena, int capacity) {
+    m_arena = &arena;
+    m_capacity = std::max(1, capacity);
+    m_events = arena.allocate<ContactEvent>(m_capacity);
+    m_eventCount = 0;
+}
+
+void ContactListener::addEvent(ContactEvent::Type type, b2Contact* contact, float impulse) {
+    b2Fixture* fixtureA = contact->GetFixtureA();
+    b2Fixture* fixtureB = contact->GetFixtureB();
+    if(fixtureB->IsSensor())
+        std::swap(fixtureA, fixtureB); // Le propriétaire du capteur en premier
+    int agentA = Circle::getCircleID(fixtureA->GetBody());
+    int agentB = Circle::getCircleID(fixtureB->GetBody());
+    if((agentA < 0 && agentB < 0) || !m_arena)
+        return;
+    if(fixtureA->IsSensor())
+        type = type == ContactEvent::Type::Begin ? ContactEvent::Type::AggroEnter : ContactEvent::Type::AggroExit;
+
+    if(m_eventCount == m_capacity) {
+        // Plus d'événements que prévu : on double dans l'arène, l'ancien tampon y reste jusqu'au reset
+        ContactEvent* events = m_arena->allocate<ContactEvent>(2 * (std::size_t)m_capacity);
+        std::memcpy(events, m_events, m_eventCount * sizeof(ContactEvent));
+        m_events = events;
+        m_capacity *= 2;
+    }
+    m_events[m_eventCount++] = { type, agentA, agentB, impulse };
+}
+
+void ContactListener::BeginContact(b2Contact* contact) {
+    addEvent(ContactEvent::Type::Begin, contact, 0.f);
+}
+
+void ContactListener::EndContact(b2Contact* contact) {
+    addEvent(ContactEvent::Type::End, contact, 0.f);
+}
+
+void ContactListener::PostSolve(b2Contact* contact, const b2ContactImpulse* impulse) {
+    float normalImpulse = 0.f;
+    for(int i = 0; i < impulse->count; i++)
+        normalImpulse += impulse->normalImpulses[i];
+    addEvent(ContactEvent::Type::Hit, contact, normalImpulse);
+}
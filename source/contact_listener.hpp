@@ -0,0 +1,73 @@
+#pragma once
+
+#include <box2d/box2d.h>
+#include <cstdint>
+#include <span>
+
+#include "frame_arena.hpp"
+
+/**
+ * @struct ContactEvent
+ * @brief One collision event reported by Box2D during a world step.
+ */
+struct ContactEvent {
+    /**
+     * @enum Type
+     * @brief The Box2D callback the event comes from.
+     */
+    enum class Type : std::uint8_t {
+        Begin, // BeginContact: the fixtures start touching
+        End, // EndContact: they stop touching
+        Hit, // PostSolve: the solver pushed them apart
+        AggroEnter, // BeginContact of an aggro sensor: agentB entered the aggro radius of agentA
+        AggroExit // EndContact of an aggro sensor: agentB left it
+    };
+
+    Type type;
+    int agentA; // Circle ID, -1 for a wall
+    int agentB;
+    float impulse; // Sum of the normal impulses (N·s), Hit only
+};
+
+/**
+ * @class ContactListener
+ * @brief Records the contacts of a world step into a flat buffer, for the game systems to read in one batch after the step.
+ *
+ * The Box2D callbacks run in the middle of b2World::Step(), while the world is locked: they only
+ * append an event, with the circle IDs read from the body user data (see Circle::getCircleID()).
+ * Contacts between two walls are not recorded. Sensor contacts become aggro events, with the
+ * owner of the sensor as agentA. The buffer lives in the frame arena of the tick
+ * and is sized at beginStep() for the worst case, so recording does not allocate. The callbacks
+ * made outside beginStep()/endStep() (bodies destroyed between ticks...) are ignored.
+ */
+class ContactListener : public b2ContactListener {
+private:
+    ContactEvent* m_events{ nullptr };
+    int m_eventCount{ 0 };
+    int m_capacity{ 0 };
+    FrameArena* m_arena{ nullptr }; // nullptr outside beginStep()/endStep()
+
+    void addEvent(ContactEvent::Type type, b2Contact* contact, float impulse);
+
+public:
+    /**
+     * @brief Clears the events and prepares the buffer for the next world step.
+     * @param arena The frame arena of the thread stepping the world.
+     * @param capacity The number of events expected, the buffer grows in the arena beyond it.
+     */
+    void beginStep(FrameArena& arena, int capacity);
+
+    /**
+     * @brief Stops recording, the events stay readable.
+     */
+    void endStep() { m_arena = nullptr; }
+
+    /**
+     * @brief Gets the events of the last world step, in the order Box2D reported them. Valid until the arena is reset.
+     */
+    std::span<const ContactEvent> getEvents() const { return { m_events, (std::size_t)m_eventCount }; }
+
+    void BeginContact(b2Contact* contact) override;
+    void EndContact(b2Contact* contact) override;
+    void PostSolve(b2Contact* contact, const b2ContactImpulse* impulse) override;
+};
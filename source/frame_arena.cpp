@@ -0,0 +1,65 @@
+#include "frame_arena.hpp"
+
+#include <algorithm>
+#include <cstdint>
+
+/**
+ * @brief Allocates the first block.
+ * @param capacity The size of the first block, in bytes.
+ */
+FrameArena::FrameArena(std::size_t capacity) {
+    addBlock(std::max<std::size_t>(capacity, 1));
+}
+
+void FrameArena::addBlock(std::size_t minimumSize) {
+    std::size_t size = std::max(minimumSize, m_blocks.empty() ? std::size_t(0) : 2 * m_blocks.back().size);
+    if(!m_blocks.empty())
+        m_usedBefore += m_used;
+    m_blocks.push_back({ std::make_unique_for_overwrite<std::byte[]>(size), size });
+    m_used = 0;
+}
+
+/**
+ * @brief Gets uninitialised memory, valid until the next reset().
+ * @param size The number of bytes.
+ * @param alignment The alignment, a power of two.
+ * @return The memory.
+ */
+void* FrameArena::allocate(std::size_t size, std::size_t alignment) {
+    Block* block = &m_blocks.back();
+    std::uintptr_t start = (std::uintptr_t)block->memory.get();
+    std::size_t offset = ((start + m_used + alignment - 1) & ~(std::uintptr_t)(alignment - 1)) - start;
+    if(offset + size > block->size) {
+        addBlock(size + alignment); // Assez pour la pire marge d'alignement
+        block = &m_blocks.back();
+        start = (std::uintptr_t)block->memory.get();
+        offset = ((start + alignment - 1) & ~(std::uintptr_t)(alignment - 1)) - start;
+    }
+    m_used = offset + size;
+    m_peak = std::max(m_peak, getUsedBytes());
+    return block->memory.get() + offset;
+}
+
+/**
+ * @brief Releases every allocation at once and merges the blocks, without running any destructor.
+ */
+void FrameArena::reset() {
+    if(m_blocks.size() > 1) {
+        // Un seul bloc de la taille totale : le prochain tick tiendra dedans
+        std::size_t capacity = getCapacity();
+        m_blocks.clear();
+        m_blocks.push_back({ std::make_unique_for_overwrite<std::byte[]>(capacity), capacity });
+    }
+    m_used = 0;
+    m_usedBefore = 0;
+}
+
+/**
+ * @brief Gets the total size of the blocks.
+ */
+std::size_t FrameArena::getCapacity() const {
+    std::size_t capacity = 0;
+    for(const Block& block : m_blocks)
+        capacity += block.size;
+    return capacity;
+}
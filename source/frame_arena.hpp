@@ -0,0 +1,120 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <vector>
+
+/**
+ * @class FrameArena
+ * @brief Bump-pointer allocator for the scratch data of one tick, released all at once by reset().
+ *
+ * An allocation moves a pointer forward, a deallocation does nothing. When the current block is
+ * full a bigger one is added; reset() then merges the blocks into a single one, so after a few
+ * ticks the arena stops touching the heap. An arena is used by one thread at a time: the parallel
+ * phases take the arena of their thread (see Simulation::getFrameArena()).
+ */
+class FrameArena {
+public:
+    static constexpr std::size_t DEFAULT_CAPACITY = 64 * 1024; // Octets
+
+private:
+    /**
+     * @struct Block
+     * @brief One chunk of memory, used from its start.
+     */
+    struct Block {
+        std::unique_ptr<std::byte[]> memory;
+        std::size_t size;
+    };
+
+    std::vector<Block> m_blocks;
+    std::size_t m_used{ 0 }; // In the last block
+    std::size_t m_usedBefore{ 0 }; // In the previous blocks
+    std::size_t m_peak{ 0 }; // Highest getUsedBytes() since the construction
+
+    void addBlock(std::size_t minimumSize);
+
+public:
+    /**
+     * @brief Allocates the first block.
+     * @param capacity The size of the first block, in bytes.
+     */
+    explicit FrameArena(std::size_t capacity = DEFAULT_CAPACITY);
+
+    FrameArena(FrameArena&&) = default;
+    FrameArena& operator=(FrameArena&&) = default;
+
+    /**
+     * @brief Gets uninitialised memory, valid until the next reset().
+     * @param size The number of bytes.
+     * @param alignment The alignment, a power of two.
+     * @return The memory.
+     */
+    void* allocate(std::size_t size, std::size_t alignment = alignof(std::max_align_t));
+
+    /**
+     * @brief Gets an uninitialised array, valid until the next reset().
+     * @param count The number of elements.
+     */
+    template<typename T>
+    T* allocate(std::size_t count) { return static_cast<T*>(allocate(count * sizeof(T), alignof(T))); }
+
+    /**
+     * @brief Releases every allocation at once and merges the blocks, without running any destructor.
+     */
+    void reset();
+
+    /**
+     * @brief Gets the number of bytes allocated since the last reset(), alignment padding included.
+     */
+    std::size_t getUsedBytes() const { return m_usedBefore + m_used; }
+
+    /**
+     * @brief Gets the highest getUsedBytes() reached, for sizing the first block.
+     */
+    std::size_t getPeakBytes() const { return m_peak; }
+
+    /**
+     * @brief Gets the total size of the blocks.
+     */
+    std::size_t getCapacity() const;
+};
+
+/**
+ * @class ArenaAllocator
+ * @brief STL allocator taking its memory from a FrameArena, so that standard containers can hold scratch data.
+ *
+ * Deallocating does nothing: a growing container leaves its old buffers in the arena until the
+ * next reset(). The containers must not outlive the tick.
+ */
+template<typename T>
+class ArenaAllocator {
+private:
+    FrameArena* m_arena;
+
+    template<typename U>
+    friend class ArenaAllocator;
+
+public:
+    using value_type = T;
+
+    explicit ArenaAllocator(FrameArena& arena) : m_arena(&arena) {}
+
+    template<typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) : m_arena(other.m_arena) {}
+
+    T* allocate(std::size_t count) { return m_arena->allocate<T>(count); }
+    void deallocate(T*, std::size_t) {}
+
+    FrameArena& getArena() const { return *m_arena; }
+
+    template<typename U>
+    bool operator==(const ArenaAllocator<U>& other) const { return m_arena == other.m_arena; }
+};
+
+/**
+ * @brief std::vector whose buffer lives in a FrameArena.
+ */
+template<typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
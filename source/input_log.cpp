@@ -0,0 +1,356 @@
+#include "input_log.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <fstream>
+#include <limits>
+
+#include "collision_filter.hpp"
+
+static constexpr char MAGIC[4] = { 'D', 'G', 'I', 'L' };
+static constexpr std::uint8_t VERSION = 3; // 2: settings of the simulation in the header, 3: 5 control bits
+
+static constexpr int CONTROL_BITS = 5; // Directions and AgentStore::IDLE_CONTROL
+static constexpr std::uint8_t CONTROL_MASK = (1 << CONTROL_BITS) - 1;
+static constexpr int INLINE_LENGTH_BITS = 2; // Bits of (length - 1) stored next to the control
+static constexpr std::uint8_t CONTINUATION_BIT = 0x80;
+static constexpr int MAX_CONTINUATION_BYTES = 5; // 2 + 5 * 7 bits couvrent une longueur sur 32 bits
+static constexpr std::uint32_t MAX_AGENTS = 1000000; // Au-delà, le fichier est corrompu plutôt qu'enregistré
+static constexpr int MAX_SOLVER_ITERATIONS = 100;
+
+/**
+ * @brief Writes an unsigned integer in little endian order.
+ */
+template<typename T>
+static void writeValue(std::ofstream& file, T value) {
+    for(std::size_t i = 0; i < sizeof(T); i++)
+        file.put((char)((value >> (8 * i)) & 0xFF));
+}
+
+/**
+ * @brief Reads an unsigned integer written by writeValue().
+ */
+template<typename T>
+static bool readValue(std::ifstream& file, T& value) {
+    value = 0;
+    for(std::size_t i = 0; i < sizeof(T); i++) {
+        int byte = file.get();
+        if(byte == std::char_traits<char>::eof())
+            return false;
+        value |= (T)byte << (8 * i);
+    }
+    return true;
+}
+
+/**
+ * @brief Writes a float as its IEEE 754 bits.
+ */
+static void writeFloat(std::ofstream& file, float value) {
+    writeValue<std::uint32_t>(file, std::bit_cast<std::uint32_t>(value));
+}
+
+/**
+ * @brief Reads a float written by writeFloat().
+ */
+static bool readFloat(std::ifstream& file, float& value) {
+    std::uint32_t bits;
+    if(!readValue(file, bits))
+        return false;
+    value = std::bit_cast<float>(bits);
+    return true;
+}
+
+static bool readBool(std::ifstream& file, bool& value) {
+    std::uint8_t byte;
+    if(!readValue(file, byte))
+        return false;
+    value = byte != 0;
+    return true;
+}
+
+static bool readInt(std::ifstream& file, int& value) {
+    std::uint32_t bits;
+    if(!readValue(file, bits))
+        return false;
+    value = (int)bits;
+    return true;
+}
+
+/**
+ * @brief Writes the settings of the simulation, except the seed and the circle count written before them.
+ */
+static void writeSettings(std::ofstream& file, const SimulationSettings& settings) {
+    writeValue<std::uint32_t>(file, (std::uint32_t)settings.teamCount);
+    writeFloat(file, settings.circleRadius);
+    writeFloat(file, settings.arenaSize.x);
+    writeFloat(file, settings.arenaSize.y);
+    writeValue<std::uint8_t>(file, settings.hasPlayer);
+    writeFloat(file, settings.timeStep);
+    writeValue<std::uint32_t>(file, (std::uint32_t)settings.velocityIterations);
+    writeValue<std::uint32_t>(file, (std::uint32_t)settings.positionIterations);
+    writeValue<std::uint8_t>(file, settings.visionEnabled);
+    writeFloat(file, settings.vision.range);
+    writeFloat(file, settings.vision.fieldOfView);
+    writeValue<std::uint32_t>(file, (std::uint32_t)settings.vision.maxRays);
+    writeValue<std::uint8_t>(file, settings.botsChaseEnemies);
+    writeFloat(file, settings.chaseRange);
+    writeFloat(file, settings.contactDamage);
+    writeValue<std::uint8_t>(file, settings.teammatesCollide);
+    writeFloat(file, settings.aggroRadius);
+    writeValue<std::uint8_t>(file, settings.useContactFilter);
+    writeValue<std::uint8_t>(file, settings.allowSleeping);
+    writeValue<std::uint8_t>(file, settings.aiSleep);
+    writeValue<std::uint32_t>(file, (std::uint32_t)settings.aiWakePeriod);
+    writeFloat(file, settings.aiDecisionRate);
+    writeFloat(file, settings.aiBudgetMs);
+}
+
+/**
+ * @brief Reads settings written by writeSettings(), in the same order.
+ */
+static bool readSettings(std::ifstream& file, SimulationSettings& settings) {
+    return readInt(file, settings.teamCount)
+        && readFloat(file, settings.circleRadius)
+        && readFloat(file, settings.arenaSize.x)
+        && readFloat(file, settings.arenaSize.y)
+        && readBool(file, settings.hasPlayer)
+        && readFloat(file, settings.timeStep)
+        && readInt(file, settings.velocityIterations)
+        && readInt(file, settings.positionIterations)
+        && readBool(file, settings.visionEnabled)
+        && readFloat(file, settings.vision.range)
+        && readFloat(file, settings.vision.fieldOfView)
+        && readInt(file, settings.vision.maxRays)
+        && readBool(file, settings.botsChaseEnemies)
+        && readFloat(file, settings.chaseRange)
+        && readFloat(file, settings.contactDamage)
+        && readBool(file, settings.teammatesCollide)
+        && readFloat(file, settings.aggroRadius)
+        && readBool(file, settings.useContactFilter)
+        && readBool(file, settings.allowSleeping)
+        && readBool(file, settings.aiSleep)
+        && readInt(file, settings.aiWakePeriod)
+        && readFloat(file, settings.aiDecisionRate)
+        && readFloat(file, settings.aiBudgetMs);
+}
+
+/**
+ * @brief Checks that settings read from a file can build a simulation.
+ */
+static bool areSettingsValid(const SimulationSettings& settings) {
+    auto isPositive = [](float value) { return std::isfinite(value) && value > 0.f; };
+    return settings.circleCount >= 0 && (std::uint32_t)settings.circleCount <= MAX_AGENTS
+        && settings.teamCount >= 1 && settings.teamCount <= CollisionFilter::MAX_TEAMS
+        && isPositive(settings.circleRadius) && isPositive(settings.arenaSize.x) && isPositive(settings.arenaSize.y)
+        && isPositive(settings.timeStep) && settings.timeStep <= 1.f
+        && settings.velocityIterations >= 1 && settings.velocityIterations <= MAX_SOLVER_ITERATIONS
+        && settings.positionIterations >= 0 && settings.positionIterations <= MAX_SOLVER_ITERATIONS
+        && settings.vision.maxRays >= 0;
+}
+
+void InputLog::encodeRun(std::vector<std::uint8_t>& stream, const Run& run) {
+    std::uint32_t rest = run.length - 1;
+    std::uint8_t head = run.control | ((rest & ((1 << INLINE_LENGTH_BITS) - 1)) << CONTROL_BITS);
+    rest >>= INLINE_LENGTH_BITS;
+    stream.push_back(rest ? head | CONTINUATION_BIT : head);
+    while(rest) {
+        std::uint8_t byte = rest & 0x7F;
+        rest >>= 7;
+        stream.push_back(rest ? byte | CONTINUATION_BIT : byte);
+    }
+}
+
+/**
+ * @brief Decodes the run starting at an offset of a stream.
+ * @param stream The encoded runs.
+ * @param offset The first byte of the run, moved past its last byte.
+ * @param run Receives the run.
+ * @return false if the run goes past the end of the stream or its length does not fit in 32 bits.
+ */
+bool InputLog::decodeRun(const std::vector<std::uint8_t>& stream, std::size_t& offset, Run& run) {
+    if(offset >= stream.size())
+        return false;
+    std::uint8_t head = stream[offset++];
+    std::uint64_t rest = (head >> CONTROL_BITS) & ((1 << INLINE_LENGTH_BITS) - 1);
+    int shift = INLINE_LENGTH_BITS;
+    for(std::uint8_t byte = head; byte & CONTINUATION_BIT; shift += 7) {
+        if(offset >= stream.size() || shift >= INLINE_LENGTH_BITS + 7 * MAX_CONTINUATION_BYTES)
+            return false;
+        byte = stream[offset++];
+        rest |= (std::uint64_t)(byte & 0x7F) << shift;
+    }
+    if(rest >= std::numeric_limits<std::uint32_t>::max()) // length = rest + 1 doit tenir sur 32 bits
+        return false;
+    run.control = head & CONTROL_MASK;
+    run.length = (std::uint32_t)rest + 1;
+    return true;
+}
+
+/**
+ * @brief Closes the open run of every agent.
+ */
+void InputLog::flush() {
+    for(std::size_t agent = 0; agent < m_runs.size(); agent++) {
+        if(m_runs[agent].length > 0)
+            encodeRun(m_streams[agent], m_runs[agent]);
+        m_runs[agent].length = 0;
+    }
+}
+
+/**
+ * @brief Clears the log and starts recording a new battle.
+ * @param settings The settings of the simulation being recorded.
+ * @param agentCount The number of agents in the simulation.
+ */
+void InputLog::startRecording(const SimulationSettings& settings, int agentCount) {
+    m_settings = settings;
+    m_settings.circleCount = agentCount;
+    m_tickCount = 0;
+    m_streams.assign(agentCount, {});
+    m_runs.assign(agentCount, {});
+    m_readOffsets.assign(agentCount, 0);
+    m_readTicks = 0;
+}
+
+/**
+ * @brief Appends the controls of every agent for one tick.
+ * @param controls The controls of each agent (see AgentStore::controls), indexed by agent.
+ */
+void InputLog::recordTick(const std::vector<std::uint8_t>& controls) {
+    for(std::size_t agent = 0; agent < m_runs.size(); agent++) {
+        Run& run = m_runs[agent];
+        std::uint8_t control = controls[agent];
+        if(run.length > 0 && run.control == control) {
+            run.length++;
+            continue;
+        }
+        if(run.length > 0)
+            encodeRun(m_streams[agent], run);
+        run.control = control;
+        run.length = 1;
+    }
+    m_tickCount++;
+}
+
+/**
+ * @brief Rewinds the log to its first tick.
+ */
+void InputLog::startReplay() {
+    flush();
+    m_readOffsets.assign(m_streams.size(), 0);
+    m_readTicks = 0;
+}
+
+/**
+ * @brief Reads the controls of every agent for the next tick.
+ * @param controls Receives the controls of each agent (see AgentStore::controls), indexed by agent.
+ * @return false once every recorded tick has been read or if a stream ends early, controls are then left unchanged.
+ */
+bool InputLog::readTick(std::vector<std::uint8_t>& controls) {
+    if(isReplayFinished())
+        return false;
+
+    for(std::size_t agent = 0; agent < m_streams.size(); agent++) {
+        if(m_runs[agent].length == 0 && !decodeRun(m_streams[agent], m_readOffsets[agent], m_runs[agent]))
+            return false; // Impossible après load(), qui a décodé chaque flux
+    }
+    for(std::size_t agent = 0; agent < m_streams.size(); agent++) {
+        Run& run = m_runs[agent];
+        controls[agent] = run.control;
+        run.length--;
+    }
+    m_readTicks++;
+    return true;
+}
+
+/**
+ * @brief Writes the log to a binary file.
+ * @param path The file path.
+ * @return true on success.
+ */
+bool InputLog::save(const std::string& path) {
+    flush();
+
+    std::ofstream file(path, std::ios::binary);
+    if(!file)
+        return false;
+
+    file.write(MAGIC, sizeof(MAGIC));
+    writeValue<std::uint8_t>(file, VERSION);
+    writeValue<std::uint32_t>(file, m_settings.seed);
+    writeValue<std::uint32_t>(file, (std::uint32_t)m_streams.size());
+    writeSettings(file, m_settings);
+    writeValue<std::uint64_t>(file, (std::uint64_t)m_tickCount);
+    for(const std::vector<std::uint8_t>& stream : m_streams) {
+        writeValue<std::uint32_t>(file, (std::uint32_t)stream.size());
+        file.write((const char*)stream.data(), stream.size());
+    }
+    return (bool)file;
+}
+
+/**
+ * @brief Reads a log written by save() and rewinds it.
+ *
+ * The file is rejected unless its settings can build a simulation and every stream decodes
+ * to exactly the recorded tick count, ending on its last byte.
+ * @param path The file path.
+ * @return true on success.
+ */
+bool InputLog::load(const std::string& path) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    std::streamoff fileSize = file.tellg();
+    file.seekg(0);
+    char magic[sizeof(MAGIC)];
+    std::uint8_t version;
+    SimulationSettings settings;
+    std::uint32_t agentCount;
+    std::uint64_t tickCount;
+    if(!file.read(magic, sizeof(magic)) || !std::equal(magic, magic + sizeof(magic), MAGIC))
+        return false;
+    // Les anciens logs n'ont pas les réglages ni les mises au repos : les rejouer donnerait une autre bataille
+    if(!readValue(file, version) || version != VERSION)
+        return false;
+    if(!readValue(file, settings.seed) || !readValue(file, agentCount) || !readSettings(file, settings) || !readValue(file, tickCount))
+        return false;
+    settings.circleCount = (int)std::min(agentCount, MAX_AGENTS + 1);
+    if(!areSettingsValid(settings) || tickCount > (std::uint64_t)std::numeric_limits<long long>::max())
+        return false;
+
+    startRecording(settings, (int)agentCount);
+    for(std::vector<std::uint8_t>& stream : m_streams) {
+        std::uint32_t size;
+        if(!readValue(file, size) || size > fileSize - file.tellg()) // Pas d'allocation pour un fichier tronqué
+            return false;
+        stream.resize(size);
+        if(!file.read((char*)stream.data(), size))
+            return false;
+
+        // Les runs doivent couvrir exactement tickCount ticks et finir sur le dernier octet
+        std::uint64_t ticks = 0;
+        std::size_t offset = 0;
+        Run run;
+        while(offset < stream.size()) {
+            if(!decodeRun(stream, offset, run))
+                return false;
+            ticks += run.length;
+            if(ticks > tickCount)
+                return false;
+        }
+        if(ticks != tickCount)
+            return false;
+    }
+    m_tickCount = (long long)tickCount;
+    return true;
+}
+
+/**
+ * @brief Gets the size of the encoded controls, headers excluded.
+ * @return The number of bytes.
+ */
+std::size_t InputLog::getByteSize() const {
+    std::size_t size = 0;
+    for(std::size_t agent = 0; agent < m_streams.size(); agent++)
+        size += m_streams[agent].size() + (m_runs[agent].length > 0 ? 1 : 0);
+    return size;
+}
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "simulation_settings.hpp"
+
+/**
+ * @class InputLog
+ * @brief Compact record of the controls of every agent, tick by tick, enough to replay a seeded battle.
+ *
+ * Each agent has its own stream of runs (same control for several ticks in a row). A run is stored
+ * as one byte holding the 5 control bits (see AgentStore::controls) and the low 2 bits of its length, followed by LEB128 bytes
+ * for the rest of the length when needed: a bot that holds its controls for a second costs 2 bytes.
+ * The header keeps the seed and every setting of the recorded simulation, so that a replay rebuilds
+ * the same battle whatever the command line.
+ */
+class InputLog {
+private:
+    /**
+     * @struct Run
+     * @brief Run of identical controls, while recording (open run) or replaying (current run).
+     */
+    struct Run {
+        std::uint8_t control{ 0 };
+        std::uint32_t length{ 0 }; // Remaining ticks when replaying
+    };
+
+    SimulationSettings m_settings; // Of the recorded simulation, seed included
+    long long m_tickCount{ 0 };
+    std::vector<std::vector<std::uint8_t>> m_streams; // Encoded runs, one stream per agent
+    std::vector<Run> m_runs; // Open run of each agent when recording, current run when replaying
+    std::vector<std::size_t> m_readOffsets; // Next byte to decode in each stream when replaying
+    long long m_readTicks{ 0 };
+
+    static void encodeRun(std::vector<std::uint8_t>& stream, const Run& run);
+
+    /**
+     * @brief Decodes the run starting at an offset of a stream.
+     * @param stream The encoded runs.
+     * @param offset The first byte of the run, moved past its last byte.
+     * @param run Receives the run.
+     * @return false if the run goes past the end of the stream or its length does not fit in 32 bits.
+     */
+    static bool decodeRun(const std::vector<std::uint8_t>& stream, std::size_t& offset, Run& run);
+    void flush();
+
+public:
+    /**
+     * @brief Clears the log and starts recording a new battle.
+     * @param settings The settings of the simulation being recorded.
+     * @param agentCount The number of agents in the simulation.
+     */
+    void startRecording(const SimulationSettings& settings, int agentCount);
+
+    /**
+     * @brief Appends the controls of every agent for one tick.
+     * @param controls The controls of each agent (see AgentStore::controls), indexed by agent.
+     */
+    void recordTick(const std::vector<std::uint8_t>& controls);
+
+    /**
+     * @brief Rewinds the log to its first tick.
+     */
+    void startReplay();
+
+    /**
+     * @brief Reads the controls of every agent for the next tick.
+     * @param controls Receives the controls of each agent (see AgentStore::controls), indexed by agent.
+     * @return false once every recorded tick has been read or if a stream ends early, controls are then left unchanged.
+     */
+    bool readTick(std::vector<std::uint8_t>& controls);
+
+    /**
+     * @brief Writes the log to a binary file.
+     * @param path The file path.
+     * @return true on success.
+     */
+    bool save(const std::string& path);
+
+    /**
+     * @brief Reads a log written by save() and rewinds it.
+     *
+     * The file is rejected unless its settings can build a simulation and every stream decodes
+     * to exactly the recorded tick count, ending on its last byte.
+     * @param path The file path.
+     * @return true on success.
+     */
+    bool load(const std::string& path);
+
+    /**
+     * @brief Gets the settings of the recorded simulation, to build the one replaying it.
+     * SimulationSettings::circleCount is the agent count of the log.
+     */
+    const SimulationSettings& getSettings() const { return m_settings; }
+
+    std::uint32_t getSeed() const { return m_settings.seed; }
+    int getAgentCount() const { return (int)m_streams.size(); }
+    long long getTickCount() const { return m_tickCount; }
+    bool isReplayFinished() const { return m_readTicks >= m_tickCount; }
+
+    /**
+     * @brief Gets the size of the encoded controls, headers excluded.
+     * @return The number of bytes.
+     */
+    std::size_t getByteSize() const;
+};
@@ -1,64 +1,489 @@
-#include "main.hpp"
-
-static constexpr float FPS = 60.f; // static limite au fichier 
-static constexpr float WALL_THICKNESS = 10.f;
-
-int main() {
-    sf::RenderWindow window(sf::VideoMode((unsigned int)WINDOW_WIDTH, (unsigned int)WINDOW_HEIGHT), "The Game !");
-    b2Vec2 gravity(0.f, 0.f);
-    b2World world(gravity);
-
-    std::vector<Wall> walls; // emplace_back construit directement lobjet dans le vecteur
-    walls.emplace_back(world, WINDOW_WIDTH / 2, WALL_THICKNESS / 2, WINDOW_WIDTH, WALL_THICKNESS); // top
-    walls.emplace_back(world, WINDOW_WIDTH / 2, WINDOW_HEIGHT - WALL_THICKNESS / 2, WINDOW_WIDTH, WALL_THICKNESS); // bottom
-    walls.emplace_back(world, WINDOW_WIDTH - WALL_THICKNESS / 2, WINDOW_HEIGHT / 2, WALL_THICKNESS, WINDOW_HEIGHT); // right
-    walls.emplace_back(world, WALL_THICKNESS / 2, WINDOW_HEIGHT / 2, WALL_THICKNESS, WINDOW_HEIGHT); // left
-
-    std::vector<Circle> circles;
-    for(int i = 0; i < 20; i++)
-        circles.emplace_back(world, 20.f);
-        
-    while(window.isOpen()) {
-        sf::Event event;
-        while(window.pollEvent(event)) {
-            if(event.type == sf::Event::Closed)
-                window.close();
-        }
-
-        world.Step(1.f / FPS, 8, 3);
-
-        window.clear();
-
-        for(Circle& circle : circles)
-        {
-            //circle.updateVision(world, circles);
-
-            if(circle.m_instanceID == 0)
-                circle.applyControl();
-            else
-                circle.applyControl(circle.botControl(window));
-            circle.draw(window);
-        }
-
-        for(const Wall& wall : walls)
-            wall.draw(window);
-        window.setFramerateLimit((unsigned int)FPS);
-        window.display();
-    }
-
-    return 0;
-}
-
-
-/*
-Sujet  rflechir :
-Passer les parametres par valeur ou par rfrence ? Ajouter autant de 'const' que possible
-    Pour des parametres leger :
-     -> La diffrence de performance est pratiquement insignifiante dans ce cas, donc il est prfrable de privilgier la lisibilit.
-ko Ajouter les Logs (=> Trace File, vraiment (pas) ncssaire quand tout est sur un composant et qu'on peut debug?)
-Ajouter les tests
-Ajouter les commentaires de documentation (utiliser un gnrateur de page html automatique, Doxygen ?)
-S'assurer d'utliser le plus de Callback possible (=> poster les messages, lire les msgs en buffer)
-ok Grer le mode Release/Debug
-ok Mettre en place Git
-*/
+#include "main.hpp"
+
+static constexpr long long DEFAULT_HEADLESS_TICKS = 10000;
+static constexpr const char* WINDOW_TITLE = "The Game !";
+static constexpr const char* USAGE =
+    "[--headless] [--batch K] [--threads N] [--ticks N] [--seed S] [--circles N] [--arena W H] [--record FILE] [--replay FILE] [--trace FILE] [--chase] [--no-ai-sleep] [--ai-rate HZ] [--ai-budget MS] [--aggro R] [--damage D] [--governor] [--quality-order LIST] [--speed X] [--check-replay] [--bench-math]";
+
+/**
+ * @struct Options
+ * @brief Command line options.
+ */
+struct Options {
+    bool headless{ false };
+    int battleCount{ 0 }; // > 0 runs a batch of battles instead of the game
+    int threadCount{ 0 }; // Threads of the batch or of the perception and decision phases, 0 uses every hardware thread
+    long long ticks{ DEFAULT_HEADLESS_TICKS }; // Ticks of the headless run, tick limit of each battle in batch mode
+    std::uint32_t seed{ 0 }; // Seed of the simulation, first seed of the batch
+    int circleCount{ 0 }; // > 0 overrides the default number of circles
+    sf::Vector2f arenaSize{ WINDOW_WIDTH, WINDOW_HEIGHT }; // Pixels, may be larger than the window
+    std::string recordPath; // Non empty: the controls are recorded into this file
+    std::string replayPath; // Non empty: the controls are replayed from this file
+    bool chase{ false }; // Bots chase their nearest enemy instead of the mouse / arena centre
+    bool aiSleep{ true }; // Bots without a target go idle, see SimulationSettings
+    float aiDecisionRate{ 0.f }; // Decisions per second of each bot, 0 decides every tick
+    float aiBudgetMs{ 0.f }; // > 0 caps the decision time of a tick
+    float aggroRadius{ 0.f }; // > 0 gives each circle an aggro sensor, see SimulationSettings
+    float contactDamage{ 0.f }; // Health lost per N·s of impulse between enemies, see SimulationSettings
+    QualitySettings quality; // Windowed only: degrades the quality under load, see QualityGovernor
+    float timeScale{ 1.f }; // Initial speed of the windowed game, 0 runs it as fast as possible
+    bool benchMath{ false }; // Only runs the micro-benchmark of Utils against the standard library
+    bool checkReplay{ false }; // Records a headless battle of --ticks ticks, replays it and compares every tick
+    std::string tracePath; // Non empty: the timeline of every thread is saved into this file, see Trace
+};
+
+/**
+ * @brief Builds the simulation settings from the options, or from the log when replaying.
+ * @param options The command line options.
+ * @param replayLog The log to replay, nullptr when not replaying.
+ * @return The settings.
+ */
+static SimulationSettings makeSettings(const Options& options, const InputLog* replayLog) {
+    if(replayLog)
+        return replayLog->getSettings(); // Tout ce qui change la bataille vient du log, pas de la ligne de commande
+
+    SimulationSettings settings;
+    settings.seed = options.seed;
+    settings.botsChaseEnemies = options.chase;
+    settings.contactDamage = options.contactDamage;
+    settings.aggroRadius = options.aggroRadius;
+    settings.aiSleep = options.aiSleep;
+    settings.aiDecisionRate = options.aiDecisionRate;
+    settings.aiBudgetMs = options.aiBudgetMs;
+    settings.arenaSize = options.arenaSize;
+    if(options.circleCount > 0)
+        settings.circleCount = options.circleCount;
+    return settings;
+}
+
+/**
+ * @brief Saves the recorded controls, if recording was requested, and prints their size.
+ * @param options The command line options.
+ * @param recordLog The recorded log.
+ * @param timeStep The duration of one tick (s).
+ */
+static void saveRecord(const Options& options, InputLog& recordLog, float timeStep) {
+    if(options.recordPath.empty())
+        return;
+    if(!recordLog.save(options.recordPath)) {
+        std::cerr << "Cannot write " << options.recordPath << std::endl;
+        return;
+    }
+
+    double seconds = recordLog.getTickCount() * timeStep;
+    std::cout << "Recorded " << recordLog.getTickCount() << " ticks of " << recordLog.getAgentCount() << " agents (seed "
+              << recordLog.getSeed() << ") in " << recordLog.getByteSize() << " bytes";
+    if(seconds > 0 && recordLog.getAgentCount() > 0)
+        std::cout << " (" << recordLog.getByteSize() / seconds / recordLog.getAgentCount() << " bytes/agent/s)";
+    std::cout << std::endl;
+}
+
+/**
+ * @brief Reads the player controls from the keyboard arrows.
+ * @return The controls, indexed by Circle::Direction.
+ */
+static std::bitset<4> readKeyboardControl() {
+    std::bitset<4> directions;
+    directions[Circle::Up] = sf::Keyboard::isKeyPressed(sf::Keyboard::Up);
+    directions[Circle::Down] = sf::Keyboard::isKeyPressed(sf::Keyboard::Down);
+    directions[Circle::Right] = sf::Keyboard::isKeyPressed(sf::Keyboard::Right);
+    directions[Circle::Left] = sf::Keyboard::isKeyPressed(sf::Keyboard::Left);
+    return directions;
+}
+
+/**
+ * @brief Reads the speed keys: 1 for real time, 2 and 3 for 2x and 10x, 4 for as fast as possible.
+ * @param event The event.
+ * @param timeScale Receives the new speed, see SimulationThread::setTimeScale().
+ * @return False if the event is not a speed key.
+ */
+static bool readTimeScaleKey(const sf::Event& event, float& timeScale) {
+    if(event.type != sf::Event::KeyPressed)
+        return false;
+    switch(event.key.code) {
+        case sf::Keyboard::Num1: timeScale = 1.f; return true;
+        case sf::Keyboard::Num2: timeScale = 2.f; return true;
+        case sf::Keyboard::Num3: timeScale = 10.f; return true;
+        case sf::Keyboard::Num4: timeScale = 0.f; return true;
+        default: return false;
+    }
+}
+
+/**
+ * @brief Builds the window title, which shows the speed when it is not real time.
+ * @param timeScale The speed, see SimulationThread::setTimeScale().
+ */
+static std::string getWindowTitle(float timeScale) {
+    if(timeScale == 1.f)
+        return WINDOW_TITLE;
+    std::ostringstream title;
+    title << WINDOW_TITLE << " (";
+    if(timeScale > 0.f)
+        title << "x" << timeScale;
+    else
+        title << "max speed";
+    title << ")";
+    return title.str();
+}
+
+/**
+ * @brief Saves the trace, if tracing was requested.
+ * @param options The command line options.
+ */
+static void saveTrace(const Options& options) {
+    if(options.tracePath.empty())
+        return;
+    Trace::stop();
+    if(!Trace::save(options.tracePath))
+        std::cerr << "Cannot write " << options.tracePath << std::endl;
+    else
+        std::cout << "Trace saved to " << options.tracePath << " (open it in https://ui.perfetto.dev or chrome://tracing)" << std::endl;
+}
+
+/**
+ * @brief Runs the game in a window: the player drives circle 0, the bots chase the mouse.
+ *
+ * Physics runs at a fixed TICK_RATE on a SimulationThread, whatever the frame rate: each frame
+ * only sends the inputs and the view area and draws the latest snapshot, interpolated from the time
+ * it was published. The Camera zooms (wheel) and pans (right or middle drag) over the arena,
+ * F3 shows the ProfilerOverlay. Keys 1 to 4 fast-forward the battle (x1, x2, x10, as fast as possible): the
+ * simulation thread then runs several ticks per frame and only the latest state is drawn. With --governor, a QualityGovernor trades quality for time under load,
+ * except for the solver iterations while a log is recorded or replayed.
+ * @param options The command line options.
+ * @param replayLog The log to replay, nullptr when not replaying.
+ * @return The process exit code.
+ */
+static int runWindowed(const Options& options, InputLog* replayLog) {
+    float timeScale = options.timeScale;
+    sf::RenderWindow window(sf::VideoMode((unsigned int)WINDOW_WIDTH, (unsigned int)WINDOW_HEIGHT), getWindowTitle(timeScale));
+    window.setVerticalSyncEnabled(true);
+
+    Simulation simulation(makeSettings(options, replayLog));
+    ThreadPool threadPool(options.threadCount);
+    simulation.setThreadPool(&threadPool);
+    InputLog recordLog;
+    if(!options.recordPath.empty())
+        simulation.setRecordLog(&recordLog);
+    simulation.setReplayLog(replayLog);
+
+    Renderer renderer;
+    Camera camera(window, simulation.getSettings().arenaSize);
+    Profiler profiler; // Thread de rendu, celui de la simulation est dans SimulationThread
+    ProfilerOverlay profilerOverlay(window);
+    SimulationThread simulationThread(simulation);
+    QualityGovernor governor(options.quality, simulation.getSettings(), std::cout);
+    simulationThread.setQualityGovernor(&governor);
+    simulationThread.setTimeScale(timeScale);
+    simulationThread.start();
+
+    while(window.isOpen()) {
+        ScopedTimer frameTimer(&profiler, ProfilePhase::Frame);
+        TRACE_SCOPE("frame");
+        {
+            ScopedTimer timer(&profiler, ProfilePhase::Events);
+            TRACE_SCOPE("events");
+            sf::Event event;
+            while(window.pollEvent(event)) {
+                if(event.type == sf::Event::Closed)
+                    window.close();
+                camera.handleEvent(event, window);
+                profilerOverlay.handleEvent(event);
+                if(readTimeScaleKey(event, timeScale)) {
+                    simulationThread.setTimeScale(timeScale);
+                    window.setTitle(getWindowTitle(timeScale));
+                }
+            }
+        }
+        window.setView(camera.getView());
+
+        TickInput input;
+        input.botTarget = window.mapPixelToCoords(sf::Mouse::getPosition(window));
+        input.playerControl = readKeyboardControl();
+        simulationThread.setInput(input);
+        simulationThread.setViewArea(camera.getVisibleArea());
+
+        // Le thread de simulation avance seul : on dessine le dernier état publié, interpolé
+        const RenderSnapshot& snapshot = simulationThread.getLatestSnapshot();
+        if(profilerOverlay.isVisible()) {
+            ProfileReport report = snapshot.profile;
+            profiler.saveReport(report); // Ajoute les phases du thread de rendu
+            profilerOverlay.update(report);
+        }
+        {
+            ScopedTimer timer(&profiler, ProfilePhase::Draw);
+            TRACE_SCOPE("draw");
+            renderer.clear();
+            renderer.setPixelScale(camera.getPixelScale());
+            renderer.setDetailScale(snapshot.detailScale);
+            snapshot.draw(renderer, snapshot.getAlpha(std::chrono::steady_clock::now()));
+            window.clear();
+            renderer.draw(window); // Deux appels de dessin, quel que soit le nombre de cercles
+            profilerOverlay.draw();
+        }
+        simulationThread.setDrawTime(profiler.getLastTime(ProfilePhase::Draw));
+        {
+            ScopedTimer timer(&profiler, ProfilePhase::Display);
+            TRACE_SCOPE("display");
+            window.display();
+        }
+    }
+
+    simulationThread.stop(); // Le log d'enregistrement n'est plus modifié après ça
+    saveRecord(options, recordLog, simulation.getSettings().timeStep);
+    return 0;
+}
+
+/**
+ * @brief Runs the simulation without any window, as fast as the CPU allows.
+ * @param options The command line options.
+ * @param replayLog The log to replay, nullptr when not replaying. The whole log is then replayed.
+ * @return The process exit code.
+ */
+static int runHeadless(const Options& options, InputLog* replayLog) {
+    SimulationSettings settings = makeSettings(options, replayLog);
+    if(!replayLog)
+        settings.hasPlayer = false;
+    Simulation simulation(settings);
+    ThreadPool threadPool(options.threadCount);
+    simulation.setThreadPool(&threadPool);
+    InputLog recordLog;
+    if(!options.recordPath.empty())
+        simulation.setRecordLog(&recordLog);
+    simulation.setReplayLog(replayLog);
+
+    TickInput input;
+    input.botTarget = settings.arenaSize / 2.f;
+
+    long long ticks = replayLog ? replayLog->getTickCount() : options.ticks;
+    auto start = std::chrono::steady_clock::now();
+    for(long long i = 0; i < ticks; i++)
+        simulation.step(input);
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    std::cout << simulation.getTickCount() << " ticks, " << simulation.getCircleCount() << " circles (seed "
+              << settings.seed << ", " << threadPool.getThreadCount() << " threads, " << Steering::getInstructionSet() << " steering) in " << elapsed.count() << " s (" << simulation.getTickCount() / elapsed.count()
+              << " ticks/s)" << std::endl;
+    double agentTicks = (double)simulation.getTickCount() * simulation.getCircleCount();
+    std::cout << AgentStore::getBytesPerAgent() + sizeof(Circle) << " bytes/agent, "
+              << (agentTicks > 0 ? elapsed.count() * 1e9 / agentTicks : 0.) << " ns/agent/tick" << std::endl;
+    saveRecord(options, recordLog, settings.timeStep);
+    return 0;
+}
+
+/**
+ * @brief Hashes the part of a snapshot a replay must reproduce exactly (FNV-1a).
+ *
+ * SimulationSnapshot::decisionCursor and CircleState::decisionDue are left out: they only drive the
+ * decisions, which a replay does not run.
+ * @param snapshot The state of the simulation.
+ * @return The hash.
+ */
+static std::uint64_t hashReplayedState(const SimulationSnapshot& snapshot) {
+    std::uint64_t hash = 14695981039346656037ull;
+    auto add = [&hash](std::uint32_t value) {
+        for(int i = 0; i < 4; i++) {
+            hash ^= (value >> (8 * i)) & 0xFF;
+            hash *= 1099511628211ull;
+        }
+    };
+    auto addFloat = [&add](float value) { add(std::bit_cast<std::uint32_t>(value)); };
+    for(const CircleState& state : snapshot.circles) {
+        addFloat(state.position.x);
+        addFloat(state.position.y);
+        addFloat(state.bodyAngle);
+        addFloat(state.linearVelocity.x);
+        addFloat(state.linearVelocity.y);
+        addFloat(state.angularVelocity);
+        addFloat(state.health);
+        add(state.controls);
+        add(state.awake);
+        add(state.aiActive);
+        add((std::uint32_t)state.aggroTarget);
+        add(state.aggroCount);
+    }
+    add((std::uint32_t)snapshot.winnerID);
+    return hash;
+}
+
+/**
+ * @brief Records a headless battle, replays it in a second simulation built from the log, and checks that
+ * both go through the same states, tick by tick. The bots only go idle and wake up when they have
+ * targets to lose, so check the defaults and a fight, e.g. --chase --ai-rate 10 --aggro 60 --damage 1.
+ * @param options The command line options: the settings of the battle (--chase, --aggro...) and its length (--ticks).
+ * @return 0 if the replay matches, 1 if it diverges.
+ */
+static int runReplayCheck(const Options& options) {
+    SimulationSettings settings = makeSettings(options, nullptr);
+    settings.hasPlayer = false;
+    ThreadPool threadPool(options.threadCount);
+    TickInput input;
+    input.botTarget = settings.arenaSize / 2.f;
+    SimulationSnapshot snapshot;
+
+    InputLog log;
+    std::vector<std::uint64_t> hashes;
+    hashes.reserve((std::size_t)options.ticks);
+    {
+        Simulation recorded(settings);
+        recorded.setThreadPool(&threadPool);
+        recorded.setRecordLog(&log);
+        for(long long i = 0; i < options.ticks; i++) {
+            recorded.step(input);
+            recorded.saveSnapshot(snapshot);
+            hashes.push_back(hashReplayedState(snapshot));
+        }
+    }
+
+    Simulation replayed(log.getSettings());
+    replayed.setThreadPool(&threadPool);
+    replayed.setReplayLog(&log);
+    for(std::size_t tick = 0; tick < hashes.size(); tick++) {
+        replayed.step(input);
+        replayed.saveSnapshot(snapshot);
+        if(hashReplayedState(snapshot) != hashes[tick]) {
+            std::cout << "Replay diverges at tick " << tick + 1 << " of " << hashes.size() << " (seed " << settings.seed << ")" << std::endl;
+            return 1;
+        }
+    }
+    std::cout << "Replay matches the recording over " << hashes.size() << " ticks of " << replayed.getCircleCount()
+              << " circles (seed " << settings.seed << ")" << std::endl;
+    return 0;
+}
+
+/**
+ * @brief Runs independent headless battles on every core and reports each result.
+ * @param options The command line options.
+ * @return The process exit code.
+ */
+static int runBatch(const Options& options) {
+    BatchSettings settings;
+    settings.battleCount = options.battleCount;
+    settings.maxTicks = options.ticks;
+    settings.threadCount = options.threadCount;
+    settings.simulation = makeSettings(options, nullptr);
+    BatchRunner runner(settings);
+
+    std::vector<BattleResult> results = runner.run();
+    for(const BattleResult& result : results) {
+        std::cout << "battle " << result.battleIndex << " (seed " << result.seed << "): ";
+        if(result.winnerID >= 0)
+            std::cout << "circle " << result.winnerID << " wins";
+        else
+            std::cout << "no winner";
+        std::cout << " after " << result.ticks << " ticks (" << result.seconds << " s)" << std::endl;
+    }
+    std::cout << results.size() << " battles on " << runner.getThreadCount() << " threads: "
+              << runner.getBattlesPerSecond() << " battles/s" << std::endl;
+    return 0;
+}
+
+/**
+ * @brief Entry point.
+ *
+ * Usage: game [--headless] [--batch K] [--threads N] [--ticks N] [--seed S] [--circles N] [--arena W H] [--record FILE] [--replay FILE] [--trace FILE] [--chase] [--no-ai-sleep] [--ai-rate HZ] [--ai-budget MS] [--aggro R] [--damage D] [--governor] [--quality-order LIST] [--speed X] [--check-replay] [--bench-math]
+ */
+int main(int argc, char* argv[]) {
+    Options options;
+    options.seed = std::random_device()();
+
+    for(int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if(arg == "--headless")
+            options.headless = true;
+        else if(arg == "--batch" && i + 1 < argc)
+            options.battleCount = std::stoi(argv[++i]);
+        else if(arg == "--threads" && i + 1 < argc)
+            options.threadCount = std::stoi(argv[++i]);
+        else if(arg == "--ticks" && i + 1 < argc)
+            options.ticks = std::stoll(argv[++i]);
+        else if(arg == "--seed" && i + 1 < argc)
+            options.seed = (std::uint32_t)std::stoul(argv[++i]);
+        else if(arg == "--circles" && i + 1 < argc)
+            options.circleCount = std::stoi(argv[++i]);
+        else if(arg == "--arena" && i + 2 < argc) {
+            options.arenaSize.x = std::stof(argv[++i]);
+            options.arenaSize.y = std::stof(argv[++i]);
+        }
+        else if(arg == "--record" && i + 1 < argc)
+            options.recordPath = argv[++i];
+        else if(arg == "--replay" && i + 1 < argc)
+            options.replayPath = argv[++i];
+        else if(arg == "--trace" && i + 1 < argc)
+            options.tracePath = argv[++i];
+        else if(arg == "--ai-rate" && i + 1 < argc)
+            options.aiDecisionRate = std::stof(argv[++i]);
+        else if(arg == "--ai-budget" && i + 1 < argc)
+            options.aiBudgetMs = std::stof(argv[++i]);
+        else if(arg == "--no-ai-sleep")
+            options.aiSleep = false;
+        else if(arg == "--aggro" && i + 1 < argc)
+            options.aggroRadius = std::stof(argv[++i]);
+        else if(arg == "--damage" && i + 1 < argc)
+            options.contactDamage = std::stof(argv[++i]);
+        else if(arg == "--speed" && i + 1 < argc)
+            options.timeScale = std::stof(argv[++i]);
+        else if(arg == "--governor")
+            options.quality.enabled = true;
+        else if(arg == "--quality-order" && i + 1 < argc) {
+            if(!QualityGovernor::parsePriority(argv[++i], options.quality.priority)) {
+                std::cerr << "Unknown or repeated quality knob in " << argv[i] << " (render, vision, ai, solver)" << std::endl;
+                return 1;
+            }
+        }
+        else if(arg == "--chase")
+            options.chase = true;
+        else if(arg == "--bench-math")
+            options.benchMath = true;
+        else if(arg == "--check-replay")
+            options.checkReplay = true;
+        else {
+            std::cerr << "Unknown argument: " << arg << std::endl;
+            std::cerr << "Usage: " << argv[0] << " " << USAGE << std::endl;
+            return 1;
+        }
+    }
+
+    if(options.benchMath) {
+        MathBenchmark::run(std::cout);
+        return 0;
+    }
+    InputLog replayLog;
+    if(!options.replayPath.empty() && !replayLog.load(options.replayPath)) {
+        std::cerr << "Cannot read replay " << options.replayPath << " (missing, corrupted or recorded by an older version)" << std::endl;
+        return 1;
+    }
+    InputLog* replay = options.replayPath.empty() ? nullptr : &replayLog;
+    if(options.quality.enabled && (!options.recordPath.empty() || replay)) {
+        // Le log ne contient pas les itérations du solveur : les changer ferait diverger la rediffusion
+        options.quality.pinned[(int)QualityKnob::Solver] = true;
+        std::cout << "Quality governor: solver iterations pinned while recording or replaying" << std::endl;
+    }
+
+    if(!options.tracePath.empty()) {
+        Trace::start();
+        Trace::setThreadName("main");
+    }
+    int exitCode;
+    if(options.checkReplay)
+        exitCode = runReplayCheck(options);
+    else if(options.battleCount > 0)
+        exitCode = runBatch(options);
+    else
+        exitCode = options.headless ? runHeadless(options, replay) : runWindowed(options, replay);
+    saveTrace(options); // Tous les threads tracés sont terminés
+    return exitCode;
+}
+
+
+/*
+Sujet à réflechir :
+Passer les parametres par valeur ou par référence ? Ajouter autant de 'const' que possible
+    Pour des parametres leger :
+     -> La différence de performance est pratiquement insignifiante dans ce cas, donc il est préférable de privilégier la lisibilité.
+ko Ajouter les Logs (=> Trace File, vraiment (pas) nécéssaire quand tout est sur un composant et qu'on peut debug?)
+Ajouter les tests
+Ajouter les commentaires de documentation (utiliser un générateur de page html automatique, Doxygen ?)
+S'assurer d'utliser le plus de Callback possible (=> poster les messages, lire les msgs en buffer)
+ok Gérer le mode Release/Debug
+ok Mettre en place Git
+*/
@@ -1,9 +1,27 @@
-#pragma once
-
-#include <SFML/Graphics.hpp>
-#include <box2d/box2d.h>
-//#include <bitset> // Gestion de bits
-
-#include "circle.hpp"
-#include "wall.hpp"
-#include "constants.hpp"
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <box2d/box2d.h>
+//#include <bitset> // Gestion de bits
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+
+#include "circle.hpp"
+#include "wall.hpp"
+#include "simulation.hpp"
+#include "simulation_thread.hpp"
+#include "batch.hpp"
+#include "camera.hpp"
+#include "input_log.hpp"
+#include "math_benchmark.hpp"
+#include "profiler.hpp"
+#include "profiler_overlay.hpp"
+#include "quality_governor.hpp"
+#include "trace.hpp"
+#include "renderer.hpp"
+#include "constants.hpp"
@@ -0,0 +1,94 @@
+#include "math_benchmark.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <random>
+#include <vector>
+
+#include "utils.hpp"
+
+static constexpr int REPETITIONS = 50; // On garde le meilleur passage, le moins perturbé
+static constexpr Utils::Accuracy LEVELS[] = { Utils::Accuracy::Coarse, Utils::Accuracy::Fine, Utils::Accuracy::Exact };
+static const char* const LEVEL_NAMES[] = { "coarse", "fine", "libm" };
+
+/**
+ * @brief Times the best of REPETITIONS runs of a batch.
+ * @return The time per value, in nanoseconds.
+ */
+template<typename F>
+static double timePerValue(int valueCount, F&& batch) {
+    double best = 1e30;
+    for(int repetition = 0; repetition < REPETITIONS; repetition++) {
+        auto start = std::chrono::steady_clock::now();
+        batch();
+        std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+        best = std::min(best, elapsed.count());
+    }
+    return best / valueCount;
+}
+
+/**
+ * @brief Prints one line of the report.
+ */
+static void printLine(std::ostream& out, const char* function, int level, double nanoseconds, double maxError) {
+    out << std::left << std::setw(8) << function << std::setw(8) << LEVEL_NAMES[level] << std::right << std::fixed
+        << std::setprecision(2) << std::setw(8) << nanoseconds << " ns/value   max error " << std::scientific
+        << std::setprecision(2) << maxError << std::defaultfloat << std::endl;
+}
+
+/**
+ * @brief Runs every measure and prints one line per function and level.
+ * @param out The stream receiving the report.
+ * @param valueCount The number of inputs per measure.
+ */
+void MathBenchmark::run(std::ostream& out, int valueCount) {
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> angle(-100.f, 100.f); // Les angles des corps s'accumulent au fil des tours
+    std::uniform_real_distribution<float> coordinate(-50.f, 50.f);
+    std::uniform_real_distribution<float> square(0.f, 2500.f);
+
+    std::vector<float> angles(valueCount), xs(valueCount), ys(valueCount), values(valueCount);
+    for(int i = 0; i < valueCount; i++) {
+        angles[i] = angle(rng);
+        xs[i] = coordinate(rng);
+        ys[i] = coordinate(rng);
+        values[i] = square(rng);
+    }
+    std::vector<float> first(valueCount), second(valueCount);
+
+    out << valueCount << " values, best of " << REPETITIONS << " runs" << std::endl;
+    for(int level = 0; level < 3; level++) {
+        double nanoseconds = timePerValue(valueCount, [&]() {
+            Utils::sinCosArray(angles.data(), first.data(), second.data(), valueCount, LEVELS[level]);
+        });
+        double maxError = 0;
+        for(int i = 0; i < valueCount; i++) {
+            maxError = std::max(maxError, std::abs(first[i] - std::sin((double)angles[i])));
+            maxError = std::max(maxError, std::abs(second[i] - std::cos((double)angles[i])));
+        }
+        printLine(out, "sincos", level, nanoseconds, maxError);
+    }
+    for(int level = 0; level < 3; level++) {
+        double nanoseconds = timePerValue(valueCount, [&]() {
+            Utils::atan2Array(ys.data(), xs.data(), first.data(), valueCount, LEVELS[level]);
+        });
+        double maxError = 0;
+        for(int i = 0; i < valueCount; i++)
+            maxError = std::max(maxError, std::abs(first[i] - std::atan2((double)ys[i], (double)xs[i])));
+        printLine(out, "atan2", level, nanoseconds, maxError);
+    }
+    for(int level = 0; level < 3; level++) {
+        double nanoseconds = timePerValue(valueCount, [&]() {
+            Utils::sqrtArray(values.data(), first.data(), valueCount, LEVELS[level]);
+        });
+        double maxError = 0; // Relative
+        for(int i = 0; i < valueCount; i++) {
+            double exact = std::sqrt((double)values[i]);
+            if(exact > 0)
+                maxError = std::max(maxError, std::abs(first[i] - exact) / exact);
+        }
+        printLine(out, "sqrt", level, nanoseconds, maxError);
+    }
+}
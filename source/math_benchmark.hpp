@@ -0,0 +1,20 @@
+#pragma once
+
+#include <ostream>
+
+/**
+ * @class MathBenchmark
+ * @brief Micro-benchmark of the Utils approximations against the standard library.
+ *
+ * For each function and accuracy level, times the array version over random inputs in the ranges
+ * met in the simulation and measures its maximum error against the double precision function.
+ */
+class MathBenchmark {
+public:
+    /**
+     * @brief Runs every measure and prints one line per function and level.
+     * @param out The stream receiving the report.
+     * @param valueCount The number of inputs per measure.
+     */
+    static void run(std::ostream& out, int valueCount = 1 << 16);
+};
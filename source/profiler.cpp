@@ -0,0 +1,107 @@
+#include "profiler.hpp"
+
+#include <algorithm>
+
+static constexpr const char* PHASE_NAMES[] = {
+    "tick", "vision", "decision", "applyControl", "world step", "  collide", "  solve", "    solveInit",
+    "    solveVelocity", "    solvePosition", "  broadphase", "  solveTOI", "snapshot", "events", "draw", "display",
+    "frame"
+};
+static constexpr const char* COUNTER_NAMES[] = { "awake bodies", "contacts", "raycasts", "contact events", "active bots", "decisions" };
+
+static_assert(sizeof(PHASE_NAMES) / sizeof(PHASE_NAMES[0]) == (int)ProfilePhase::Count, "one name per phase");
+static_assert(sizeof(COUNTER_NAMES) / sizeof(COUNTER_NAMES[0]) == (int)ProfileCounter::Count, "one name per counter");
+
+void Profiler::History::add(float value) {
+    samples[next] = value;
+    next = (next + 1) % HISTORY_SIZE;
+    count = std::min(count + 1, HISTORY_SIZE);
+}
+
+ProfileStats Profiler::History::getStats(std::array<float, HISTORY_SIZE>& scratch) const {
+    ProfileStats stats;
+    stats.sampleCount = count;
+    if(count == 0)
+        return stats;
+
+    // Les échantillons valides sont [0, count) : le tampon ne tourne qu'une fois plein
+    stats.last = samples[(next + HISTORY_SIZE - 1) % HISTORY_SIZE];
+    stats.min = *std::min_element(samples.begin(), samples.begin() + count);
+    float sum = 0.f;
+    for(int i = 0; i < count; i++)
+        sum += samples[i];
+    stats.average = sum / count;
+
+    std::copy(samples.begin(), samples.begin() + count, scratch.begin());
+    int rank = std::max(0, (count * 99 + 99) / 100 - 1); // ceil(0.99 * count) - 1
+    std::nth_element(scratch.begin(), scratch.begin() + rank, scratch.begin() + count);
+    stats.p99 = scratch[rank];
+    return stats;
+}
+
+/**
+ * @brief Records the timings Box2D measured during the last b2World::Step().
+ * @param profile The profile, see b2World::GetProfile().
+ */
+void Profiler::addWorldProfile(const b2Profile& profile) {
+    addTime(ProfilePhase::WorldStep, profile.step);
+    addTime(ProfilePhase::Collide, profile.collide);
+    addTime(ProfilePhase::Solve, profile.solve);
+    addTime(ProfilePhase::SolveInit, profile.solveInit);
+    addTime(ProfilePhase::SolveVelocity, profile.solveVelocity);
+    addTime(ProfilePhase::SolvePosition, profile.solvePosition);
+    addTime(ProfilePhase::Broadphase, profile.broadphase);
+    addTime(ProfilePhase::SolveTOI, profile.solveTOI);
+}
+
+/**
+ * @brief Computes the statistics of every phase and counter recorded by this profiler.
+ *
+ * The entries this profiler never recorded are left untouched, so that the reports of
+ * several profilers can be merged into one.
+ * @param report Receives the statistics.
+ */
+void Profiler::saveReport(ProfileReport& report) {
+    for(int i = 0; i < (int)ProfilePhase::Count; i++) {
+        if(m_phases[i].count > 0)
+            report.phases[i] = m_phases[i].getStats(m_scratch);
+        if(m_phaseAllocations[i].count > 0) {
+            report.phaseAllocations[i] = m_phaseAllocations[i].getStats(m_scratch);
+            report.phaseAllocatedBytes[i] = m_phaseAllocatedBytes[i].getStats(m_scratch);
+        }
+    }
+    for(int i = 0; i < (int)ProfileCounter::Count; i++) {
+        if(m_counters[i].count > 0)
+            report.counters[i] = m_counters[i].getStats(m_scratch);
+    }
+}
+
+const char* Profiler::getName(ProfilePhase phase) {
+    return PHASE_NAMES[(int)phase];
+}
+
+const char* Profiler::getName(ProfileCounter counter) {
+    return COUNTER_NAMES[(int)counter];
+}
+
+/**
+ * @brief Starts timing.
+ * @param profiler The profiler, nullptr disables the timer without reading the clock.
+ * @param phase The phase being timed.
+ */
+ScopedTimer::ScopedTimer(Profiler* profiler, ProfilePhase phase)
+    : m_profiler(profiler), m_phase(phase)
+{
+    if(m_profiler) {
+        m_startAllocations = AllocationTracker::getThreadCounts();
+        m_start = std::chrono::steady_clock::now();
+    }
+}
+
+ScopedTimer::~ScopedTimer() {
+    if(!m_profiler)
+        return;
+    std::chrono::duration<float, std::milli> elapsed = std::chrono::steady_clock::now() - m_start;
+    m_profiler->addTime(m_phase, elapsed.count());
+    m_profiler->addAllocations(m_phase, AllocationTracker::getThreadCounts() - m_startAllocations);
+}
@@ -0,0 +1,178 @@
+#pragma once
+
+#include <box2d/box2d.h>
+#include <array>
+#include <chrono>
+
+#include "allocation_tracker.hpp"
+
+/**
+ * @enum ProfilePhase
+ * @brief Timed parts of a tick (simulation thread) and of a frame (render thread).
+ */
+enum class ProfilePhase {
+    Tick, // Whole Simulation::step()
+    Vision,
+    Decision, // Bot controls, see Steering
+    ApplyControl,
+    WorldStep, // b2Profile::step and its parts below
+    Collide,
+    Solve,
+    SolveInit,
+    SolveVelocity,
+    SolvePosition,
+    Broadphase,
+    SolveTOI,
+    Snapshot, // Copy of the drawable state, see Simulation::saveRenderSnapshot()
+    Events,
+    Draw,
+    Display,
+    Frame, // Whole iteration of the render loop
+    Count
+};
+
+/**
+ * @enum ProfileCounter
+ * @brief Values counted once per tick.
+ */
+enum class ProfileCounter {
+    AwakeBodies,
+    Contacts, // Touching contacts
+    RayCasts, // Vision rays
+    ContactEvents, // See ContactListener
+    ActiveBots, // Bots not idle, see AgentStore::aiActive
+    Decisions, // Bots decided, see SimulationSettings::aiDecisionRate
+    Count
+};
+
+/**
+ * @struct ProfileStats
+ * @brief Summary of the history of one phase (ms) or counter.
+ */
+struct ProfileStats {
+    int sampleCount{ 0 }; // 0 when the phase was never recorded
+    float last{ 0.f };
+    float min{ 0.f };
+    float average{ 0.f };
+    float p99{ 0.f }; // 99th percentile
+};
+
+/**
+ * @struct ProfileReport
+ * @brief Summary of every phase and counter, small enough to be copied from thread to thread.
+ */
+struct ProfileReport {
+    std::array<ProfileStats, (int)ProfilePhase::Count> phases;
+    std::array<ProfileStats, (int)ProfilePhase::Count> phaseAllocations; // Heap allocations per sample
+    std::array<ProfileStats, (int)ProfilePhase::Count> phaseAllocatedBytes;
+    std::array<ProfileStats, (int)ProfileCounter::Count> counters;
+};
+
+/**
+ * @class Profiler
+ * @brief Keeps the last HISTORY_SIZE durations and allocation counts of each phase, and values of each counter.
+ *
+ * A profiler belongs to one thread: the simulation thread and the render thread each have
+ * theirs, and their reports are merged for display. Recording is a store into a ring buffer,
+ * the statistics are only computed by saveReport().
+ */
+class Profiler {
+public:
+    static constexpr int HISTORY_SIZE = 256; // Ticks or frames
+
+private:
+    /**
+     * @struct History
+     * @brief Ring buffer of samples.
+     */
+    struct History {
+        std::array<float, HISTORY_SIZE> samples{};
+        int next{ 0 }; // Slot of the next sample
+        int count{ 0 };
+
+        void add(float value);
+        float getLast() const { return count > 0 ? samples[(next + HISTORY_SIZE - 1) % HISTORY_SIZE] : 0.f; }
+        ProfileStats getStats(std::array<float, HISTORY_SIZE>& scratch) const;
+    };
+
+    std::array<History, (int)ProfilePhase::Count> m_phases;
+    std::array<History, (int)ProfilePhase::Count> m_phaseAllocations;
+    std::array<History, (int)ProfilePhase::Count> m_phaseAllocatedBytes;
+    std::array<History, (int)ProfileCounter::Count> m_counters;
+    std::array<float, HISTORY_SIZE> m_scratch; // For the percentiles, no allocation
+
+public:
+    /**
+     * @brief Records the duration of a phase.
+     * @param phase The phase.
+     * @param milliseconds The duration, in ms.
+     */
+    void addTime(ProfilePhase phase, float milliseconds) { m_phases[(int)phase].add(milliseconds); }
+
+    /**
+     * @brief Records the heap allocations of a phase.
+     * @param phase The phase.
+     * @param counts The allocations made during the phase, see AllocationScope.
+     */
+    void addAllocations(ProfilePhase phase, const AllocationCounts& counts) {
+        m_phaseAllocations[(int)phase].add((float)counts.allocations);
+        m_phaseAllocatedBytes[(int)phase].add((float)counts.bytes);
+    }
+
+    /**
+     * @brief Records the value of a counter.
+     * @param counter The counter.
+     * @param value The value for this tick.
+     */
+    void addCount(ProfileCounter counter, float value) { m_counters[(int)counter].add(value); }
+
+    /**
+     * @brief Records the timings Box2D measured during the last b2World::Step().
+     * @param profile The profile, see b2World::GetProfile().
+     */
+    void addWorldProfile(const b2Profile& profile);
+
+    /**
+     * @brief Gets the last duration recorded for a phase.
+     * @param phase The phase.
+     * @return The duration in ms, 0 if the phase was never recorded.
+     */
+    float getLastTime(ProfilePhase phase) const { return m_phases[(int)phase].getLast(); }
+
+    /**
+     * @brief Computes the statistics of every phase and counter recorded by this profiler.
+     *
+     * The entries this profiler never recorded are left untouched, so that the reports of
+     * several profilers can be merged into one.
+     * @param report Receives the statistics.
+     */
+    void saveReport(ProfileReport& report);
+
+    static const char* getName(ProfilePhase phase);
+    static const char* getName(ProfileCounter counter);
+};
+
+/**
+ * @class ScopedTimer
+ * @brief Records the time spent and the heap allocations made between its construction and its
+ * destruction as one sample of a phase.
+ */
+class ScopedTimer {
+private:
+    Profiler* m_profiler;
+    ProfilePhase m_phase;
+    std::chrono::steady_clock::time_point m_start;
+    AllocationCounts m_startAllocations;
+
+public:
+    /**
+     * @brief Starts timing.
+     * @param profiler The profiler, nullptr disables the timer without reading the clock.
+     * @param phase The phase being timed.
+     */
+    ScopedTimer(Profiler* profiler, ProfilePhase phase);
+    ~ScopedTimer();
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+};
@@ -0,0 +1,92 @@
+#include "profiler_overlay.hpp"
+
+#include <cstdio>
+#include <vector>
+
+static constexpr std::chrono::milliseconds REFRESH_PERIOD(250);
+
+/**
+ * @brief Formats one row of the table.
+ * @param name The name of the phase or counter.
+ * @param stats The statistics.
+ * @param precision The number of decimals.
+ * @param allocations The allocations per sample of the phase, nullptr for a counter.
+ * @param allocatedBytes The bytes allocated per sample of the phase, nullptr for a counter.
+ * @return The cells of the row.
+ */
+static std::vector<tgui::String> makeRow(const char* name, const ProfileStats& stats, int precision,
+                                         const ProfileStats* allocations = nullptr, const ProfileStats* allocatedBytes = nullptr) {
+    char cells[6][32] = {};
+    std::snprintf(cells[0], sizeof(cells[0]), "%.*f", precision, stats.last);
+    std::snprintf(cells[1], sizeof(cells[1]), "%.*f", precision, stats.min);
+    std::snprintf(cells[2], sizeof(cells[2]), "%.*f", precision, stats.average);
+    std::snprintf(cells[3], sizeof(cells[3]), "%.*f", precision, stats.p99);
+    if(allocations && allocations->sampleCount > 0) {
+        std::snprintf(cells[4], sizeof(cells[4]), "%.1f", allocations->average);
+        std::snprintf(cells[5], sizeof(cells[5]), "%.1f", allocatedBytes->average / 1024.f);
+    }
+    return { name, cells[0], cells[1], cells[2], cells[3], cells[4], cells[5] };
+}
+
+/**
+ * @brief Constructs a hidden overlay.
+ * @param window The window to draw to.
+ */
+ProfilerOverlay::ProfilerOverlay(sf::RenderWindow& window)
+    : m_gui(window)
+{
+    m_table = tgui::ListView::create();
+    m_table->setPosition(10, 10);
+    m_table->setSize(600, 440);
+    m_table->setTextSize(13);
+    m_table->addColumn("phase (ms) / counter", 160);
+    m_table->addColumn("last", 70, tgui::ListView::ColumnAlignment::Right);
+    m_table->addColumn("min", 70, tgui::ListView::ColumnAlignment::Right);
+    m_table->addColumn("avg", 70, tgui::ListView::ColumnAlignment::Right);
+    m_table->addColumn("p99", 70, tgui::ListView::ColumnAlignment::Right);
+    m_table->addColumn("allocs", 60, tgui::ListView::ColumnAlignment::Right); // Moyennes par échantillon
+    m_table->addColumn("KiB", 60, tgui::ListView::ColumnAlignment::Right);
+    m_table->setVisible(false);
+    m_gui.add(m_table);
+}
+
+/**
+ * @brief Toggles the overlay on F3 and forwards the event to TGUI.
+ * @param event The window event.
+ */
+void ProfilerOverlay::handleEvent(const sf::Event& event) {
+    if(event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::F3) {
+        m_table->setVisible(!m_table->isVisible());
+        m_lastRefresh = std::chrono::steady_clock::time_point(); // Rafraîchit dès l'affichage
+    }
+    m_gui.handleEvent(event);
+}
+
+/**
+ * @brief Shows the latest statistics, if the last refresh is old enough.
+ * @param report The merged report of the simulation and render threads.
+ */
+void ProfilerOverlay::update(const ProfileReport& report) {
+    auto now = std::chrono::steady_clock::now();
+    if(!m_table->isVisible() || now - m_lastRefresh < REFRESH_PERIOD)
+        return;
+    m_lastRefresh = now;
+
+    m_table->removeAllItems();
+    for(int i = 0; i < (int)ProfilePhase::Count; i++) {
+        if(report.phases[i].sampleCount > 0)
+            m_table->addItem(makeRow(Profiler::getName((ProfilePhase)i), report.phases[i], 3,
+                                     &report.phaseAllocations[i], &report.phaseAllocatedBytes[i]));
+    }
+    for(int i = 0; i < (int)ProfileCounter::Count; i++) {
+        if(report.counters[i].sampleCount > 0)
+            m_table->addItem(makeRow(Profiler::getName((ProfileCounter)i), report.counters[i], 0));
+    }
+}
+
+/**
+ * @brief Draws the overlay on top of the frame, with its own view.
+ */
+void ProfilerOverlay::draw() {
+    m_gui.draw();
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <TGUI/TGUI.hpp>
+#include <TGUI/Backends/SFML.hpp>
+#include <chrono>
+
+#include "profiler.hpp"
+
+/**
+ * @class ProfilerOverlay
+ * @brief In-game table of the phase timings and counters of a ProfileReport, drawn with TGUI.
+ *
+ * F3 shows or hides it. The table is refreshed a few times per second, not every frame, so that it stays readable.
+ */
+class ProfilerOverlay {
+private:
+    tgui::GuiSFML m_gui;
+    tgui::ListView::Ptr m_table;
+    std::chrono::steady_clock::time_point m_lastRefresh;
+
+public:
+    /**
+     * @brief Constructs a hidden overlay.
+     * @param window The window to draw to.
+     */
+    explicit ProfilerOverlay(sf::RenderWindow& window);
+
+    /**
+     * @brief Toggles the overlay on F3 and forwards the event to TGUI.
+     * @param event The window event.
+     */
+    void handleEvent(const sf::Event& event);
+
+    /**
+     * @brief Shows the latest statistics, if the last refresh is old enough.
+     * @param report The merged report of the simulation and render threads.
+     */
+    void update(const ProfileReport& report);
+
+    /**
+     * @brief Draws the overlay on top of the frame, with its own view.
+     */
+    void draw();
+
+    bool isVisible() const { return m_table->isVisible(); }
+};
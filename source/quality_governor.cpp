@@ -0,0 +1,259 @@
+#include "quality_governor.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <sstream>
+
+static constexpr float SMOOTHING = 0.05f; // Poids du dernier tick dans les moyennes glissantes (~20 ticks)
+static constexpr float HEADROOM_FRACTION = 0.6f; // Sous cette part du budget, on remonte la qualité
+static constexpr int RESTORE_COOLDOWNS = 4; // Marge tenue pendant 4 délais avant de remonter : pas de va-et-vient
+static constexpr float MIN_COST_SHARE = 0.1f; // Un réglage qui coûte moins de 10 % du budget dépassé ne vaut pas d'être baissé
+
+/**
+ * @struct SolverIterations
+ * @brief Iterations of the Box2D solver at one level.
+ */
+struct SolverIterations {
+    int velocity;
+    int position;
+};
+
+// Niveau 0 : les réglages de la simulation, les suivants ne dépassent jamais ceux-ci
+static constexpr SolverIterations SOLVER_LEVELS[] = { { 8, 3 }, { 6, 2 }, { 4, 2 }, { 3, 1 }, { 2, 1 } };
+static constexpr int VISION_RAY_LEVELS[] = { 0, 32, 16, 8, 4 };
+static constexpr float AI_RATE_LEVELS[] = { 0.f, 30.f, 15.f, 10.f, 5.f };
+static constexpr float DETAIL_SCALE_LEVELS[] = { 1.f, 0.5f, 0.25f, 0.125f };
+
+static void smooth(float& average, float value) {
+    average += SMOOTHING * (value - average);
+}
+
+/**
+ * @brief Gets the solver iterations at a level.
+ */
+static SolverIterations getSolverIterations(const SimulationSettings& base, int level) {
+    if(level == 0)
+        return { base.velocityIterations, base.positionIterations };
+    return { std::min(base.velocityIterations, SOLVER_LEVELS[level].velocity),
+             std::min(base.positionIterations, SOLVER_LEVELS[level].position) };
+}
+
+/**
+ * @brief Gets the vision rays per circle and tick at a level, 0 for no limit.
+ */
+static int getVisionRays(const SimulationSettings& base, int level) {
+    if(level == 0 || (base.vision.maxRays > 0 && base.vision.maxRays < VISION_RAY_LEVELS[level]))
+        return base.vision.maxRays;
+    return VISION_RAY_LEVELS[level];
+}
+
+/**
+ * @brief Gets the AI decision rate at a level, 0 for every tick.
+ */
+static float getAiRate(const SimulationSettings& base, int level) {
+    if(level == 0 || (base.aiDecisionRate > 0.f && base.aiDecisionRate < AI_RATE_LEVELS[level]))
+        return base.aiDecisionRate;
+    return AI_RATE_LEVELS[level];
+}
+
+/**
+ * @brief Constructs a governor at full quality.
+ * @param settings The budgets and the priority order.
+ * @param baseSettings The settings of the simulation, used as the highest quality.
+ * @param log Receives a line per change.
+ */
+QualityGovernor::QualityGovernor(const QualitySettings& settings, const SimulationSettings& baseSettings, std::ostream& log)
+    : m_settings(settings), m_baseSettings(baseSettings), m_log(&log)
+{
+}
+
+float QualityGovernor::getTickBudget() const {
+    return m_settings.tickBudgetMs > 0.f ? m_settings.tickBudgetMs : m_baseSettings.timeStep * 1000.f;
+}
+
+float QualityGovernor::getCost(QualityKnob knob) const {
+    switch(knob) {
+        case QualityKnob::Render: return m_drawMs;
+        case QualityKnob::Vision: return m_visionMs;
+        case QualityKnob::AiRate: return m_decisionMs;
+        case QualityKnob::Solver: return m_solveMs;
+        default: return 0.f;
+    }
+}
+
+/**
+ * @brief Takes the timings of the tick that just ended into account and changes at most one knob.
+ * @param profiler The profiler of the simulation thread, for the Tick, Vision and Decision phases.
+ * @param worldProfile The timings of the last world step, see b2World::GetProfile().
+ * @param drawMs The last draw time of the render thread, in ms.
+ * @return True if a knob changed: apply() must then be called.
+ */
+bool QualityGovernor::update(const Profiler& profiler, const b2Profile& worldProfile, float drawMs) {
+    smooth(m_tickMs, profiler.getLastTime(ProfilePhase::Tick));
+    smooth(m_visionMs, profiler.getLastTime(ProfilePhase::Vision));
+    smooth(m_decisionMs, profiler.getLastTime(ProfilePhase::Decision));
+    smooth(m_solveMs, worldProfile.solve);
+    smooth(m_drawMs, drawMs);
+    if(!m_settings.enabled)
+        return false;
+    if(m_cooldown > 0) {
+        m_cooldown--;
+        return false;
+    }
+
+    float tickBudget = getTickBudget();
+    bool tickOverrun = m_tickMs > tickBudget;
+    bool drawOverrun = m_drawMs > m_settings.drawBudgetMs;
+    if(tickOverrun || drawOverrun) {
+        m_headroomTicks = 0;
+        // D'abord les réglages dont le coût pèse, à défaut n'importe lequel du budget dépassé
+        for(int pass = 0; pass < 2; pass++) {
+            for(QualityKnob knob : m_settings.priority) {
+                bool isRender = knob == QualityKnob::Render;
+                if(m_settings.pinned[(int)knob] || getLevel(knob) + 1 >= getLevelCount(knob) || !(isRender ? drawOverrun : tickOverrun))
+                    continue;
+                if(pass == 0 && getCost(knob) < MIN_COST_SHARE * (isRender ? m_settings.drawBudgetMs : tickBudget))
+                    continue;
+                changeLevel(knob, 1);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool tickHeadroom = m_tickMs < HEADROOM_FRACTION * tickBudget;
+    bool drawHeadroom = m_drawMs < HEADROOM_FRACTION * m_settings.drawBudgetMs;
+    if(!tickHeadroom && !drawHeadroom) {
+        m_headroomTicks = 0;
+        return false;
+    }
+    if(++m_headroomTicks < RESTORE_COOLDOWNS * m_settings.cooldownTicks)
+        return false;
+    for(auto it = m_settings.priority.rbegin(); it != m_settings.priority.rend(); ++it) {
+        if(getLevel(*it) > 0 && (*it == QualityKnob::Render ? drawHeadroom : tickHeadroom)) {
+            changeLevel(*it, -1);
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Moves a knob by one level and logs the change.
+ * @param knob The knob.
+ * @param step +1 lowers the quality, -1 raises it.
+ */
+void QualityGovernor::changeLevel(QualityKnob knob, int step) {
+    int& level = m_levels[(int)knob];
+    std::ostream& log = *m_log;
+    log << "Quality " << (step > 0 ? "lowered" : "raised") << ": " << getName(knob) << " ";
+    writeValue(log, knob, level);
+    level += step;
+    log << " -> ";
+    writeValue(log, knob, level);
+    log << " (tick " << m_tickMs << "/" << getTickBudget() << " ms, vision " << m_visionMs << " ms, decision "
+        << m_decisionMs << " ms, solver " << m_solveMs << " ms, draw " << m_drawMs << "/" << m_settings.drawBudgetMs << " ms)" << std::endl;
+
+    m_cooldown = m_settings.cooldownTicks;
+    m_headroomTicks = 0;
+}
+
+/**
+ * @brief Writes the value of a knob at a level, e.g. "8/3" for the solver.
+ */
+void QualityGovernor::writeValue(std::ostream& out, QualityKnob knob, int level) const {
+    switch(knob) {
+        case QualityKnob::Render:
+            out << "x" << DETAIL_SCALE_LEVELS[level];
+            break;
+        case QualityKnob::Vision: {
+            int rays = getVisionRays(m_baseSettings, level);
+            if(rays > 0)
+                out << rays << " rays";
+            else
+                out << "unlimited";
+            break;
+        }
+        case QualityKnob::AiRate: {
+            float rate = getAiRate(m_baseSettings, level);
+            if(rate > 0.f)
+                out << rate << " Hz";
+            else
+                out << "every tick";
+            break;
+        }
+        case QualityKnob::Solver: {
+            SolverIterations iterations = getSolverIterations(m_baseSettings, level);
+            out << iterations.velocity << "/" << iterations.position;
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+/**
+ * @brief Sets the solver iterations, the vision rays and the AI rate of the current levels.
+ * @param simulation The simulation, between two ticks.
+ */
+void QualityGovernor::apply(Simulation& simulation) const {
+    SolverIterations iterations = getSolverIterations(m_baseSettings, getLevel(QualityKnob::Solver));
+    simulation.setSolverIterations(iterations.velocity, iterations.position);
+    simulation.setVisionRayLimit(getVisionRays(m_baseSettings, getLevel(QualityKnob::Vision)));
+    simulation.setAiDecisionRate(getAiRate(m_baseSettings, getLevel(QualityKnob::AiRate)));
+}
+
+/**
+ * @brief Gets the tessellation scale of the current Render level, see Renderer::setDetailScale().
+ */
+float QualityGovernor::getDetailScale() const {
+    return DETAIL_SCALE_LEVELS[getLevel(QualityKnob::Render)];
+}
+
+/**
+ * @brief Gets the number of levels of a knob.
+ */
+int QualityGovernor::getLevelCount(QualityKnob knob) {
+    switch(knob) {
+        case QualityKnob::Render: return (int)std::size(DETAIL_SCALE_LEVELS);
+        case QualityKnob::Vision: return (int)std::size(VISION_RAY_LEVELS);
+        case QualityKnob::AiRate: return (int)std::size(AI_RATE_LEVELS);
+        case QualityKnob::Solver: return (int)std::size(SOLVER_LEVELS);
+        default: return 1;
+    }
+}
+
+const char* QualityGovernor::getName(QualityKnob knob) {
+    static const char* const NAMES[] = { "render", "vision", "ai", "solver" };
+    static_assert(std::size(NAMES) == (int)QualityKnob::Count);
+    return NAMES[(int)knob];
+}
+
+/**
+ * @brief Reads a priority order, e.g. "render,vision,ai,solver". The knobs left out come last, in the default order.
+ * @param text The knob names separated by commas, see getName().
+ * @param priority Receives the order.
+ * @return False if a name is unknown or repeated.
+ */
+bool QualityGovernor::parsePriority(const std::string& text, std::array<QualityKnob, (int)QualityKnob::Count>& priority) {
+    std::array<QualityKnob, (int)QualityKnob::Count> order;
+    std::array<bool, (int)QualityKnob::Count> used{};
+    int count = 0;
+    std::istringstream stream(text);
+    std::string name;
+    while(std::getline(stream, name, ',')) {
+        int knob = 0;
+        while(knob < (int)QualityKnob::Count && name != getName((QualityKnob)knob))
+            knob++;
+        if(knob == (int)QualityKnob::Count || used[knob])
+            return false;
+        used[knob] = true;
+        order[count++] = (QualityKnob)knob;
+    }
+    for(QualityKnob knob : QualitySettings().priority) {
+        if(!used[(int)knob])
+            order[count++] = knob;
+    }
+    priority = order;
+    return true;
+}
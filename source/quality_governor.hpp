@@ -0,0 +1,136 @@
+#pragma once
+
+#include <box2d/box2d.h>
+#include <array>
+#include <ostream>
+#include <string>
+
+#include "profiler.hpp"
+#include "simulation.hpp"
+
+/**
+ * @enum QualityKnob
+ * @brief A setting the QualityGovernor can lower under load.
+ */
+enum class QualityKnob {
+    Render, // Tessellation of the circles, see Renderer::setDetailScale()
+    Vision, // Rays per circle and tick, see VisionSettings::maxRays
+    AiRate, // Decisions per second of each bot, see SimulationSettings::aiDecisionRate
+    Solver, // Velocity and position iterations of the Box2D solver
+    Count
+};
+
+/**
+ * @struct QualitySettings
+ * @brief Parameters of a QualityGovernor.
+ */
+struct QualitySettings {
+    bool enabled{ false };
+    float tickBudgetMs{ 0.f }; // Time a tick may take, 0 uses the time step
+    float drawBudgetMs{ 8.f }; // Time the render thread may take to prepare and draw a frame, display excluded
+    int cooldownTicks{ 30 }; // Ticks between two changes, so that the timings reflect the last one
+    std::array<QualityKnob, (int)QualityKnob::Count> priority{ // Lowered first to last, raised back in reverse order
+        QualityKnob::Render, QualityKnob::Vision, QualityKnob::AiRate, QualityKnob::Solver };
+    std::array<bool, (int)QualityKnob::Count> pinned{}; // Knobs kept at level 0 whatever the load
+};
+
+/**
+ * @class QualityGovernor
+ * @brief Trades quality for time: lowers the solver iterations, the vision rays, the AI rate and the
+ * tessellation when the ticks or the frames overrun their budget, and raises them back when there is headroom.
+ *
+ * Each knob has a few levels, level 0 being the simulation settings it was built with. The timings
+ * are smoothed over a few dozen ticks: the tick time and the vision and decision phases come from
+ * the profiler of the simulation thread, the solver time from b2World::GetProfile(), the draw time
+ * from the render thread. On an overrun, the first knob of QualitySettings::priority that is not at
+ * its lowest level and whose cost is worth cutting goes down one level; once the headroom has lasted a
+ * few cooldowns, the knobs go back up one level at a time, in reverse priority order. Every change is logged.
+ * The governor lives on the simulation thread. Lowering the solver iterations changes the physics and
+ * is not in the InputLog: the Solver knob must be pinned while a battle is recorded or replayed.
+ */
+class QualityGovernor {
+private:
+    QualitySettings m_settings;
+    SimulationSettings m_baseSettings; // Level 0 of every knob
+    std::ostream* m_log;
+    std::array<int, (int)QualityKnob::Count> m_levels{};
+    float m_tickMs{ 0.f }; // Moyennes glissantes
+    float m_visionMs{ 0.f };
+    float m_decisionMs{ 0.f };
+    float m_solveMs{ 0.f };
+    float m_drawMs{ 0.f };
+    int m_cooldown{ 0 }; // Ticks left before the next change
+    int m_headroomTicks{ 0 }; // Consecutive ticks with headroom
+
+    /**
+     * @brief Gets the tick budget in ms.
+     */
+    float getTickBudget() const;
+
+    /**
+     * @brief Gets the smoothed cost of the work a knob cuts, in ms: the solver time for Solver, the draw time for Render...
+     * @param knob The knob.
+     */
+    float getCost(QualityKnob knob) const;
+
+    /**
+     * @brief Moves a knob by one level and logs the change.
+     * @param knob The knob.
+     * @param step +1 lowers the quality, -1 raises it.
+     */
+    void changeLevel(QualityKnob knob, int step);
+
+    /**
+     * @brief Writes the value of a knob at a level, e.g. "8/3" for the solver.
+     */
+    void writeValue(std::ostream& out, QualityKnob knob, int level) const;
+
+public:
+    /**
+     * @brief Constructs a governor at full quality.
+     * @param settings The budgets and the priority order.
+     * @param baseSettings The settings of the simulation, used as the highest quality.
+     * @param log Receives a line per change.
+     */
+    QualityGovernor(const QualitySettings& settings, const SimulationSettings& baseSettings, std::ostream& log);
+
+    /**
+     * @brief Takes the timings of the tick that just ended into account and changes at most one knob.
+     * @param profiler The profiler of the simulation thread, for the Tick, Vision and Decision phases.
+     * @param worldProfile The timings of the last world step, see b2World::GetProfile().
+     * @param drawMs The last draw time of the render thread, in ms.
+     * @return True if a knob changed: apply() must then be called.
+     */
+    bool update(const Profiler& profiler, const b2Profile& worldProfile, float drawMs);
+
+    /**
+     * @brief Sets the solver iterations, the vision rays and the AI rate of the current levels.
+     * @param simulation The simulation, between two ticks.
+     */
+    void apply(Simulation& simulation) const;
+
+    /**
+     * @brief Gets the tessellation scale of the current Render level, see Renderer::setDetailScale().
+     */
+    float getDetailScale() const;
+
+    /**
+     * @brief Gets the current level of a knob, 0 being the full quality.
+     */
+    int getLevel(QualityKnob knob) const { return m_levels[(int)knob]; }
+
+    /**
+     * @brief Gets the number of levels of a knob.
+     */
+    static int getLevelCount(QualityKnob knob);
+
+    static const char* getName(QualityKnob knob);
+
+    /**
+     * @brief Reads a priority order, e.g. "render,vision,ai,solver". The knobs left out come last, in the default order.
+     * @param text The knob names separated by commas, see getName().
+     * @param priority Receives the order.
+     * @return False if a name is unknown or repeated.
+     */
+    static bool parsePriority(const std::string& text, std::array<QualityKnob, (int)QualityKnob::Count>& priority);
+};
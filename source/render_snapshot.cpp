@@ -0,0 +1,41 @@
+#include "render_snapshot.hpp"
+
+#include <algorithm>
+
+#include "utils.hpp"
+
+static constexpr float DIRECTION_LINE_LENGTH = 1.2f; // En rayons
+static constexpr float MIN_DIRECTION_LINE_RADIUS = 2.f; // En dessous de ce rayon à l'écran (px), la ligne de direction ne se voit plus
+
+/**
+ * @brief Adds the circles and the walls to the frame.
+ * @param renderer The renderer of the frame.
+ * @param alpha Interpolation factor in [0, 1] between the previous and the current transform of the circles.
+ */
+void RenderSnapshot::draw(Renderer& renderer, float alpha) const {
+    for(const RenderAgent& agent : agents) {
+        sf::Vector2f center = agent.previousPosition + alpha * (agent.position - agent.previousPosition);
+        float angle = agent.previousAngle + alpha * (agent.angle - agent.previousAngle);
+        renderer.addCircle(center, agent.radius, agent.color);
+        if(agent.radius * renderer.getPixelScale() < MIN_DIRECTION_LINE_RADIUS)
+            continue;
+        // 1e-4 près : invisible à l'écran
+        sf::Vector2f direction = Utils::polarToCartesian(agent.radius * DIRECTION_LINE_LENGTH, angle, Utils::Accuracy::Coarse);
+        renderer.addLine(center, center + direction, sf::Color::Red);
+    }
+
+    for(const sf::FloatRect& wall : walls)
+        renderer.addRectangle(wall, sf::Color::White);
+}
+
+/**
+ * @brief Computes the interpolation factor at a given time: how far it is into the tick after the last one.
+ * @param now The time of the frame.
+ * @return The factor, clamped to [0, 1].
+ */
+float RenderSnapshot::getAlpha(std::chrono::steady_clock::time_point now) const {
+    if(timeStep <= 0.f)
+        return 1.f;
+    std::chrono::duration<float> elapsed = now - publishTime;
+    return std::clamp(elapsed.count() / timeStep, 0.f, 1.f);
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <chrono>
+#include <vector>
+
+#include "profiler.hpp"
+#include "renderer.hpp"
+
+/**
+ * @struct RenderAgent
+ * @brief What the render thread needs to draw one circle.
+ */
+struct RenderAgent {
+    sf::Vector2f previousPosition; // Pixels, before the last tick
+    sf::Vector2f position; // Pixels
+    float previousAngle;
+    float angle;
+    float radius; // Pixels
+    sf::Color color;
+};
+
+/**
+ * @struct RenderSnapshot
+ * @brief Compact copy of the drawable state of a simulation, handed from the simulation thread to the render thread.
+ */
+struct RenderSnapshot {
+    std::vector<RenderAgent> agents; // Only the circles in the view area, in no particular order
+    std::vector<sf::FloatRect> walls; // Pixels, only the walls in the view area
+    long long tickCount{ 0 };
+    float timeStep{ 0.f }; // Real duration of the last tick (s), shorter when fast-forwarding, 0 when running as fast as possible. Set by SimulationThread
+    std::chrono::steady_clock::time_point publishTime; // When the last tick ended
+    ProfileReport profile; // Statistics of the simulation thread
+    float detailScale{ 1.f }; // Tessellation chosen by the QualityGovernor, see Renderer::setDetailScale()
+
+    /**
+     * @brief Adds the circles and the walls to the frame.
+     * @param renderer The renderer of the frame.
+     * @param alpha Interpolation factor in [0, 1] between the previous and the current transform of the circles.
+     */
+    void draw(Renderer& renderer, float alpha) const;
+
+    /**
+     * @brief Computes the interpolation factor at a given time: how far it is into the tick after the last one.
+     * @param now The time of the frame.
+     * @return The factor, clamped to [0, 1].
+     */
+    float getAlpha(std::chrono::steady_clock::time_point now) const;
+};
@@ -0,0 +1,103 @@
+#include "renderer.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "utils.hpp"
+
+static constexpr int MIN_CIRCLE_SEGMENTS = 4;
+static constexpr float MAX_TESSELLATION_ERROR = 0.5f; // Écart maximal entre le polygone et le cercle, en pixels écran
+
+/**
+ * @brief Constructs a Renderer.
+ * @param circleSegments The number of triangles of the largest circles.
+ */
+Renderer::Renderer(int circleSegments) {
+    // Segments divisés par deux à chaque niveau, du plus grossier au plus fin
+    std::vector<int> segmentCounts;
+    for(int segments = std::max(circleSegments, MIN_CIRCLE_SEGMENTS); segments > MIN_CIRCLE_SEGMENTS; segments /= 2)
+        segmentCounts.push_back(segments);
+    segmentCounts.push_back(MIN_CIRCLE_SEGMENTS);
+    std::reverse(segmentCounts.begin(), segmentCounts.end());
+
+    for(int segments : segmentCounts) {
+        CircleLevel level;
+        // Un point de plus que de segments : le dernier referme le cercle, pas de modulo dans addCircle
+        level.points.resize(segments + 1);
+        for(int i = 0; i <= segments; i++)
+            level.points[i] = Utils::polarToCartesian(1.f, 2 * Utils::PI * i / segments);
+        // Flèche d'un segment : r (1 - cos(pi / n))
+        level.maxScreenRadius = MAX_TESSELLATION_ERROR / (1.f - std::cos(Utils::PI / segments));
+        m_circleLevels.push_back(std::move(level));
+    }
+}
+
+/**
+ * @brief Starts a new frame, forgetting the shapes of the previous one.
+ */
+void Renderer::clear() {
+    m_triangles.clear(); // Garde la mémoire : vide le std::vector interne sans le libérer
+    m_lines.clear();
+}
+
+/**
+ * @brief Adds a filled circle.
+ * @param center The centre, in pixels.
+ * @param radius The radius, in pixels.
+ * @param color The fill color.
+ */
+void Renderer::addCircle(sf::Vector2f center, float radius, sf::Color color) {
+    float screenRadius = radius * m_pixelScale * m_detailScale;
+    const CircleLevel* level = &m_circleLevels.back();
+    for(const CircleLevel& candidate : m_circleLevels) {
+        if(screenRadius <= candidate.maxScreenRadius) {
+            level = &candidate;
+            break;
+        }
+    }
+
+    const std::vector<sf::Vector2f>& points = level->points;
+    for(std::size_t i = 0; i + 1 < points.size(); i++) {
+        m_triangles.append(sf::Vertex(center, color));
+        m_triangles.append(sf::Vertex(center + radius * points[i], color));
+        m_triangles.append(sf::Vertex(center + radius * points[i + 1], color));
+    }
+}
+
+/**
+ * @brief Adds a filled axis-aligned rectangle.
+ * @param area The rectangle, in pixels.
+ * @param color The fill color.
+ */
+void Renderer::addRectangle(const sf::FloatRect& area, sf::Color color) {
+    sf::Vector2f topLeft(area.left, area.top);
+    sf::Vector2f topRight(area.left + area.width, area.top);
+    sf::Vector2f bottomLeft(area.left, area.top + area.height);
+    sf::Vector2f bottomRight(area.left + area.width, area.top + area.height);
+    m_triangles.append(sf::Vertex(topLeft, color));
+    m_triangles.append(sf::Vertex(topRight, color));
+    m_triangles.append(sf::Vertex(bottomRight, color));
+    m_triangles.append(sf::Vertex(topLeft, color));
+    m_triangles.append(sf::Vertex(bottomRight, color));
+    m_triangles.append(sf::Vertex(bottomLeft, color));
+}
+
+/**
+ * @brief Adds a line segment.
+ * @param from The first end, in pixels.
+ * @param to The second end, in pixels.
+ * @param color The line color.
+ */
+void Renderer::addLine(sf::Vector2f from, sf::Vector2f to, sf::Color color) {
+    m_lines.append(sf::Vertex(from, color));
+    m_lines.append(sf::Vertex(to, color));
+}
+
+/**
+ * @brief Draws the frame: all the triangles, then all the lines on top.
+ * @param target The SFML render target.
+ */
+void Renderer::draw(sf::RenderTarget& target) const {
+    target.draw(m_triangles);
+    target.draw(m_lines);
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <vector>
+
+/**
+ * @class Renderer
+ * @brief Batches every shape of a frame into two vertex arrays, drawn with two draw calls.
+ *
+ * Filled shapes (circle bodies, walls) go into one array of triangles and lines (headings) into one
+ * array of lines. The arrays are cleared but keep their storage between frames, so once the
+ * largest frame has been seen, building a frame allocates nothing.
+ *
+ * Circles are tessellated according to their size on screen: the fewest segments that keep the
+ * polygon within half a pixel of the true circle, from circleSegments down to 4.
+ */
+class Renderer {
+private:
+    /**
+     * @struct CircleLevel
+     * @brief One tessellation of the unit circle.
+     */
+    struct CircleLevel {
+        std::vector<sf::Vector2f> points; // Points of the circle of radius 1, the last one closes the circle
+        float maxScreenRadius; // Largest radius on screen (px) drawn within the tolerance
+    };
+
+    sf::VertexArray m_triangles{ sf::Triangles };
+    sf::VertexArray m_lines{ sf::Lines };
+    std::vector<CircleLevel> m_circleLevels; // From the coarsest to the finest, computed once
+    float m_pixelScale{ 1.f }; // Screen pixels per world pixel
+    float m_detailScale{ 1.f }; // Below 1, coarser circles than the tolerance allows
+
+public:
+    /**
+     * @brief Constructs a Renderer.
+     * @param circleSegments The number of triangles of the largest circles.
+     */
+    explicit Renderer(int circleSegments = 30);
+
+    /**
+     * @brief Starts a new frame, forgetting the shapes of the previous one.
+     */
+    void clear();
+
+    /**
+     * @brief Sets the zoom of the frame, used to pick the tessellation of the circles.
+     * @param pixelScale The number of screen pixels per world pixel, see Camera::getPixelScale().
+     */
+    void setPixelScale(float pixelScale) { m_pixelScale = pixelScale; }
+
+    /**
+     * @brief Lowers the tessellation of the circles: they get the segments of a circle this many times smaller.
+     * @param detailScale 1 for the full quality, 0.5 for half the radius...
+     */
+    void setDetailScale(float detailScale) { m_detailScale = detailScale; }
+
+    /**
+     * @brief Adds a filled circle.
+     * @param center The centre, in pixels.
+     * @param radius The radius, in pixels.
+     * @param color The fill color.
+     */
+    void addCircle(sf::Vector2f center, float radius, sf::Color color);
+
+    /**
+     * @brief Adds a filled axis-aligned rectangle.
+     * @param area The rectangle, in pixels.
+     * @param color The fill color.
+     */
+    void addRectangle(const sf::FloatRect& area, sf::Color color);
+
+    /**
+     * @brief Adds a line segment.
+     * @param from The first end, in pixels.
+     * @param to The second end, in pixels.
+     * @param color The line color.
+     */
+    void addLine(sf::Vector2f from, sf::Vector2f to, sf::Color color);
+
+    /**
+     * @brief Draws the frame: all the triangles, then all the lines on top.
+     * @param target The SFML render target.
+     */
+    void draw(sf::RenderTarget& target) const;
+
+    float getPixelScale() const { return m_pixelScale; }
+    int getCircleSegments() const { return (int)m_circleLevels.back().points.size() - 1; }
+    std::size_t getVertexCount() const { return m_triangles.getVertexCount() + m_lines.getVertexCount(); }
+};
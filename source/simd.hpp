@@ -0,0 +1,186 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define SIMD_AVX2
+#define SIMD_SSE2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SIMD_SSE2
+#endif
+
+/*
+Types de "voies" pour écrire un calcul une seule fois et l'exécuter sur 1, 4 ou 8 floats à la fois.
+Le jeu d'instructions est choisi à la compilation (/arch:AVX2 ou -mavx2 active AVX2, SSE2 est toujours là en x64).
+Pas de FMA : toutes les voies font les mêmes opérations dans le même ordre, donc donnent les mêmes résultats.
+*/
+
+/**
+ * @struct ScalarFloats
+ * @brief One float at a time, for the fallback and the tail of the arrays.
+ */
+struct ScalarFloats {
+    using Float = float;
+    using Mask = bool;
+    static constexpr int WIDTH = 1;
+
+    static Float load(const float* p) { return *p; }
+    static void store(float* p, Float a) { *p = a; }
+    static Float set(float value) { return value; }
+    static Float add(Float a, Float b) { return a + b; }
+    static Float sub(Float a, Float b) { return a - b; }
+    static Float mul(Float a, Float b) { return a * b; }
+    static Float div(Float a, Float b) { return a / b; }
+    static Float min(Float a, Float b) { return a < b ? a : b; }
+    static Float max(Float a, Float b) { return a > b ? a : b; }
+    static Float abs(Float a) { return std::fabs(a); }
+    static Float sqrt(Float a) { return std::sqrt(a); }
+    static Float floor(Float a) { return std::floor(a); }
+    static Float round(Float a) { return std::nearbyint(a); } // Arrondi au pair le plus proche, comme les cvtps SSE
+    static Float rsqrtEstimate(Float a) {
+        // 1/sqrt par les bits du float, plus un pas de Newton : erreur relative < 1.8e-3, proche de rsqrtps
+        std::uint32_t bits;
+        std::memcpy(&bits, &a, sizeof(bits));
+        bits = 0x5F375A86u - (bits >> 1);
+        float inverse;
+        std::memcpy(&inverse, &bits, sizeof(inverse));
+        return inverse * (1.5f - 0.5f * a * inverse * inverse);
+    }
+    static Float copySign(Float magnitude, Float sign) { return std::copysign(magnitude, sign); }
+    static Mask greater(Float a, Float b) { return a > b; }
+    static Mask less(Float a, Float b) { return a < b; }
+    static Mask both(Mask a, Mask b) { return a && b; }
+    static Mask negate(Mask a) { return !a; }
+    static Float select(Mask mask, Float a, Float b) { return mask ? a : b; }
+    static void storeBitBytes(Mask bit0, Mask bit1, Mask bit2, Mask bit3, std::uint8_t* out) {
+        *out = (std::uint8_t)(bit0 | bit1 << 1 | bit2 << 2 | bit3 << 3);
+    }
+};
+
+#ifdef SIMD_SSE2
+/**
+ * @struct Sse2Floats
+ * @brief Four floats at a time.
+ */
+struct Sse2Floats {
+    using Float = __m128;
+    using Mask = __m128;
+    static constexpr int WIDTH = 4;
+
+    static Float load(const float* p) { return _mm_loadu_ps(p); }
+    static void store(float* p, Float a) { _mm_storeu_ps(p, a); }
+    static Float set(float value) { return _mm_set1_ps(value); }
+    static Float add(Float a, Float b) { return _mm_add_ps(a, b); }
+    static Float sub(Float a, Float b) { return _mm_sub_ps(a, b); }
+    static Float mul(Float a, Float b) { return _mm_mul_ps(a, b); }
+    static Float div(Float a, Float b) { return _mm_div_ps(a, b); }
+    static Float min(Float a, Float b) { return _mm_min_ps(a, b); }
+    static Float max(Float a, Float b) { return _mm_max_ps(a, b); }
+    static Float abs(Float a) { return _mm_andnot_ps(_mm_set1_ps(-0.f), a); }
+    static Float sqrt(Float a) { return _mm_sqrt_ps(a); }
+    static Float floor(Float a) {
+        // Pas de _mm_floor_ps avant SSE4.1 : troncature, puis -1 si la troncature a arrondi vers le haut
+        Float truncated = _mm_cvtepi32_ps(_mm_cvttps_epi32(a));
+        return _mm_sub_ps(truncated, _mm_and_ps(_mm_cmpgt_ps(truncated, a), _mm_set1_ps(1.f)));
+    }
+    static Float round(Float a) { return _mm_cvtepi32_ps(_mm_cvtps_epi32(a)); }
+    static Float rsqrtEstimate(Float a) { return _mm_rsqrt_ps(a); }
+    static Float copySign(Float magnitude, Float sign) {
+        Float signBit = _mm_set1_ps(-0.f);
+        return _mm_or_ps(_mm_andnot_ps(signBit, magnitude), _mm_and_ps(signBit, sign));
+    }
+    static Mask greater(Float a, Float b) { return _mm_cmpgt_ps(a, b); }
+    static Mask less(Float a, Float b) { return _mm_cmplt_ps(a, b); }
+    static Mask both(Mask a, Mask b) { return _mm_and_ps(a, b); }
+    static Mask negate(Mask a) { return _mm_xor_ps(a, _mm_castsi128_ps(_mm_set1_epi32(-1))); }
+    static Float select(Mask mask, Float a, Float b) { return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b)); }
+    static __m128i bit(Mask mask, int index) { return _mm_and_si128(_mm_castps_si128(mask), _mm_set1_epi32(1 << index)); }
+    static void storeBitBytes(Mask bit0, Mask bit1, Mask bit2, Mask bit3, std::uint8_t* out) {
+        // Un octet par voie de 32 bits, puis 32 -> 16 -> 8 bits
+        __m128i lanes = _mm_or_si128(_mm_or_si128(bit(bit0, 0), bit(bit1, 1)), _mm_or_si128(bit(bit2, 2), bit(bit3, 3)));
+        __m128i packed = _mm_packus_epi16(_mm_packs_epi32(lanes, lanes), lanes);
+        std::int32_t bytes = _mm_cvtsi128_si32(packed);
+        std::memcpy(out, &bytes, WIDTH);
+    }
+};
+#endif
+
+#ifdef SIMD_AVX2
+/**
+ * @struct Avx2Floats
+ * @brief Eight floats at a time.
+ */
+struct Avx2Floats {
+    using Float = __m256;
+    using Mask = __m256;
+    static constexpr int WIDTH = 8;
+
+    static Float load(const float* p) { return _mm256_loadu_ps(p); }
+    static void store(float* p, Float a) { _mm256_storeu_ps(p, a); }
+    static Float set(float value) { return _mm256_set1_ps(value); }
+    static Float add(Float a, Float b) { return _mm256_add_ps(a, b); }
+    static Float sub(Float a, Float b) { return _mm256_sub_ps(a, b); }
+    static Float mul(Float a, Float b) { return _mm256_mul_ps(a, b); }
+    static Float div(Float a, Float b) { return _mm256_div_ps(a, b); }
+    static Float min(Float a, Float b) { return _mm256_min_ps(a, b); }
+    static Float max(Float a, Float b) { return _mm256_max_ps(a, b); }
+    static Float abs(Float a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.f), a); }
+    static Float sqrt(Float a) { return _mm256_sqrt_ps(a); }
+    static Float floor(Float a) { return _mm256_floor_ps(a); }
+    static Float round(Float a) { return _mm256_round_ps(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+    static Float rsqrtEstimate(Float a) { return _mm256_rsqrt_ps(a); }
+    static Float copySign(Float magnitude, Float sign) {
+        Float signBit = _mm256_set1_ps(-0.f);
+        return _mm256_or_ps(_mm256_andnot_ps(signBit, magnitude), _mm256_and_ps(signBit, sign));
+    }
+    static Mask greater(Float a, Float b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+    static Mask less(Float a, Float b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+    static Mask both(Mask a, Mask b) { return _mm256_and_ps(a, b); }
+    static Mask negate(Mask a) { return _mm256_xor_ps(a, _mm256_castsi256_ps(_mm256_set1_epi32(-1))); }
+    static Float select(Mask mask, Float a, Float b) { return _mm256_blendv_ps(b, a, mask); }
+    static __m256i bit(Mask mask, int index) { return _mm256_and_si256(_mm256_castps_si256(mask), _mm256_set1_epi32(1 << index)); }
+    static void storeBitBytes(Mask bit0, Mask bit1, Mask bit2, Mask bit3, std::uint8_t* out) {
+        __m256i lanes = _mm256_or_si256(_mm256_or_si256(bit(bit0, 0), bit(bit1, 1)), _mm256_or_si256(bit(bit2, 2), bit(bit3, 3)));
+        __m128i words = _mm_packs_epi32(_mm256_castsi256_si128(lanes), _mm256_extracti128_si256(lanes, 1));
+        _mm_storel_epi64((__m128i*)out, _mm_packus_epi16(words, words));
+    }
+};
+#endif
+
+/**
+ * @brief Calls block(lanes, first) over [0, count) with the widest lane type available, then the narrower ones for the tail.
+ * @param count The number of elements.
+ * @param block Generic callable, lanes is a ScalarFloats, Sse2Floats or Avx2Floats value and first the index of its first element.
+ */
+template<typename F>
+inline void forEachSimdBlock(int count, F&& block) {
+    int first = 0;
+#ifdef SIMD_AVX2
+    for(; first + Avx2Floats::WIDTH <= count; first += Avx2Floats::WIDTH)
+        block(Avx2Floats(), first);
+#endif
+#ifdef SIMD_SSE2
+    for(; first + Sse2Floats::WIDTH <= count; first += Sse2Floats::WIDTH)
+        block(Sse2Floats(), first);
+#endif
+    for(; first < count; first++)
+        block(ScalarFloats(), first);
+}
+
+/**
+ * @brief Gets the instruction set the lane types were compiled for.
+ * @return "AVX2", "SSE2" or "scalar".
+ */
+inline const char* getSimdInstructionSet() {
+#if defined(SIMD_AVX2)
+    return "AVX2";
+#elif defined(SIMD_SSE2)
+    return "SSE2";
+#else
+    return "scalar";
+#endif
+}
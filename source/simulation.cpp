@@ -0,0 +1,595 @@
+#include "simulation.hpp"
+
+static constexpr float WALL_THICKNESS = 10.f;
+static constexpr int CIRCLES_PER_TASK = 64; // Assez pour amortir la distribution des tâches entre threads
+static constexpr int DECISION_ROUND_TASKS_PER_THREAD = 4; // Taille d'un tour de décisions quand le budget d'IA est limité
+static constexpr float GRID_CELLS_PER_DIAMETER = 1.f; // Taille des cellules de la grille, en diamètres de cercle
+static constexpr float RENDER_MARGIN_RADII = 2.f; // Marge autour de la zone à dessiner, en rayons de cercle
+// Un cercle touche au plus 6 voisins : 3 contacts par cercle, chacun donnant en général au plus un début, une fin et un choc par tick
+static constexpr int CONTACT_EVENTS_PER_CIRCLE = 9;
+// Arène d'un tick par cercle : liste de vision, entrées et sorties de Steering, événements de contact
+static constexpr std::size_t SCRATCH_BYTES_PER_CIRCLE = AgentStore::MAX_VISIBLE_AGENTS * sizeof(int)
+                                                        + sizeof(int) + 7 * sizeof(float) + sizeof(std::uint8_t)
+                                                        + CONTACT_EVENTS_PER_CIRCLE * sizeof(ContactEvent);
+// Seuils d'endormissement des bots inactifs, bien au-dessus de ceux de Box2D (b2_linearSleepTolerance...) :
+// avec un amortissement de 5/s, un bot lâché passe sous 0.2 m/s en moins d'une seconde au lieu de deux
+static constexpr float IDLE_SLEEP_SPEED = 0.2f; // m/s
+static constexpr float IDLE_SLEEP_ANGULAR_SPEED = 0.2f; // rad/s
+static constexpr long long STEADY_STATE_TICK = 2; // À partir de ce tick, un tick n'alloue plus rien (vérifié en Debug)
+
+/**
+ * @brief Constructs the arena: four walls around SimulationSettings::arenaSize and the circles at random positions.
+ * @param settings The simulation parameters.
+ */
+Simulation::Simulation(const SimulationSettings& settings)
+    : m_settings(settings), m_rng(settings.seed), m_world(b2Vec2(0.f, 0.f))
+{
+    m_world.SetContactListener(&m_contactListener);
+    const float width = settings.arenaSize.x;
+    const float height = settings.arenaSize.y;
+    m_walls.reserve(4);
+    m_walls.emplace_back(m_world, width / 2, WALL_THICKNESS / 2, width, WALL_THICKNESS); // top
+    m_walls.emplace_back(m_world, width / 2, height - WALL_THICKNESS / 2, width, WALL_THICKNESS); // bottom
+    m_walls.emplace_back(m_world, width - WALL_THICKNESS / 2, height / 2, WALL_THICKNESS, height); // right
+    m_walls.emplace_back(m_world, WALL_THICKNESS / 2, height / 2, WALL_THICKNESS, height); // left
+
+    m_agents.reserve(settings.circleCount);
+    m_circles.reserve(settings.circleCount);
+    for(int i = 0; i < settings.circleCount; i++)
+        m_circles.emplace_back(m_agents, m_world, settings.circleRadius, i % std::max(1, settings.teamCount), settings.arenaSize, m_rng);
+
+    // Filtrage par équipe dans la broadphase, puis capteurs d'aggro
+    int teamCount = std::max(1, settings.teamCount);
+    assert(teamCount <= CollisionFilter::MAX_TEAMS);
+    for(Circle& circle : m_circles) {
+        circle.setCollisionFilter(CollisionFilter::makeBodyFilter(circle.getTeam(), teamCount, settings.teammatesCollide));
+        if(settings.aggroRadius > 0.f)
+            circle.addAggroSensor(settings.aggroRadius, CollisionFilter::makeAggroFilter(circle.getTeam(), teamCount));
+    }
+    if(settings.useContactFilter)
+        m_world.SetContactFilter(&m_contactFilter);
+    m_world.SetAllowSleeping(settings.allowSleeping);
+    setThreadPool(nullptr);
+    rebuildGrid();
+}
+
+/**
+ * @brief Runs the perception and decision phases on a thread pool.
+ * @param threadPool The pool, nullptr runs everything on the calling thread.
+ */
+void Simulation::setThreadPool(ThreadPool* threadPool) {
+    m_threadPool = threadPool;
+
+    // Un thread peut prendre tous les morceaux d'une phase : chaque arène doit pouvoir tout contenir
+    std::size_t capacity = FrameArena::DEFAULT_CAPACITY + m_circles.size() * SCRATCH_BYTES_PER_CIRCLE;
+    m_frameArenas.clear();
+    for(int i = 0; i < (threadPool ? threadPool->getThreadCount() : 1); i++)
+        m_frameArenas.emplace_back(capacity);
+}
+
+/**
+ * @brief Rebuilds the spatial grid over the current circle centres.
+ */
+void Simulation::rebuildGrid() {
+    m_grid.build(m_agents.positionX, m_agents.positionY, m_agents.team, GRID_CELLS_PER_DIAMETER * 2 * m_settings.circleRadius / SCALE);
+}
+
+/**
+ * @brief Runs a phase over ranges of circle IDs, split across the thread pool if there is one.
+ * @param phase The work of the circles in [begin, end). It may only write to the slots of those circles.
+ */
+void Simulation::runChunks(const std::function<void(int begin, int end)>& phase) {
+    runChunks(0, (int)m_circles.size(), phase);
+}
+
+/**
+ * @brief Runs a phase over ranges of the circle IDs in [first, last), split across the thread pool if there is one.
+ * @param first The first circle ID.
+ * @param last One past the last circle ID.
+ * @param phase The work of the circles in [begin, end). It may only write to the slots of those circles.
+ */
+void Simulation::runChunks(int first, int last, const std::function<void(int begin, int end)>& phase) {
+    if(!m_threadPool) {
+        phase(first, last);
+        return;
+    }
+
+    // Une seule référence capturée : la lambda tient dans le petit tampon de std::function, pas d'allocation
+    // (trois captures par référence dépassent les 16 octets de libstdc++)
+    struct Chunks {
+        int first;
+        int last;
+        const std::function<void(int begin, int end)>* phase;
+    } chunks{ first, last, &phase };
+    int taskCount = (last - first + CIRCLES_PER_TASK - 1) / CIRCLES_PER_TASK;
+    m_threadPool->parallelFor(taskCount, [&chunks](int task) {
+        int begin = chunks.first + task * CIRCLES_PER_TASK;
+        (*chunks.phase)(begin, std::min(chunks.last, begin + CIRCLES_PER_TASK));
+    });
+}
+
+/**
+ * @brief Marks the bots whose decision slot is this tick, then decides the bots due, within the AI budget.
+ *
+ * With a decision rate, bot i has its slot every period ticks, shifted by i, so that each tick
+ * decides about the same number of bots; the others keep their last controls. The bots due are
+ * decided in rounds from m_decisionCursor on, wrapping around: once the budget is spent, the
+ * rounds stop and the bots still due are the first decided next tick.
+ * @param input The inputs of the tick.
+ */
+void Simulation::runDecisions(const TickInput& input) {
+    int circleCount = (int)m_circles.size();
+    if(circleCount == 0)
+        return;
+
+    int period = 1;
+    if(m_settings.aiDecisionRate > 0.f)
+        period = std::max(1, (int)std::lround(1.f / (m_settings.aiDecisionRate * m_settings.timeStep)));
+    for(int i = (int)((period - m_tickCount % period) % period); i < circleCount; i += period)
+        m_agents.decisionDue[i] = 1;
+
+    // Sans budget, un seul tour sur tous les cercles ; avec, des tours assez petits pour s'arrêter à temps
+    bool hasBudget = m_settings.aiBudgetMs > 0.f;
+    int threadCount = m_threadPool ? m_threadPool->getThreadCount() : 1;
+    int roundSize = hasBudget ? DECISION_ROUND_TASKS_PER_THREAD * CIRCLES_PER_TASK * threadCount : circleCount;
+    auto start = std::chrono::steady_clock::now();
+    for(int done = 0; done < circleCount; ) {
+        int begin = m_decisionCursor;
+        int end = std::min(circleCount, begin + std::min(roundSize, circleCount - done));
+        runChunks(begin, end, [this, &input](int chunkBegin, int chunkEnd) {
+            TRACE_SCOPE("botControl chunk");
+            int decisionCount = decideChunk(chunkBegin, chunkEnd, input);
+            m_decisionCount.fetch_add(decisionCount, std::memory_order_relaxed);
+        });
+        done += end - begin;
+        m_decisionCursor = end == circleCount ? 0 : end;
+
+        std::chrono::duration<float, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        if(hasBudget && elapsed.count() >= m_settings.aiBudgetMs)
+            break;
+    }
+}
+
+/**
+ * @brief Advances the simulation by one tick: controls every circle then steps the world.
+ *
+ * The tick runs in phases. The world is only read during perception (vision) and decision
+ * (bots, batched by Steering), which run in parallel with one result slot per circle; the forces are then applied
+ * on the calling thread before the world step.
+ * The first circle whose centre gets within one radius of the bot target wins the battle.
+ * Once the buffers have grown during the first ticks, a tick makes no heap allocation, which
+ * Debug builds assert (recording and tracing excepted: their buffers grow on purpose).
+ * @param input The inputs for this tick.
+ */
+void Simulation::step(const TickInput& input) {
+#ifndef NDEBUG
+    AllocationScope allocations;
+#endif
+    stepPhases(input);
+#ifndef NDEBUG
+    assert(m_tickCount <= STEADY_STATE_TICK || m_recordLog || Trace::isEnabled() || allocations.getCounts().allocations == 0);
+#endif
+}
+
+/**
+ * @brief Runs the phases of one tick, see step().
+ * @param input The inputs for this tick.
+ */
+void Simulation::stepPhases(const TickInput& input) {
+    ScopedTimer tickTimer(m_profiler, ProfilePhase::Tick);
+    TRACE_SCOPE("tick");
+    for(FrameArena& arena : m_frameArenas)
+        arena.reset(); // Les listes de vision du tick précédent ne sont plus valides
+    m_agents.savePreviousTransforms();
+
+    // Perception
+    if(m_settings.visionEnabled) {
+        ScopedTimer timer(m_profiler, ProfilePhase::Vision);
+        TRACE_SCOPE("vision");
+        m_rayCastCount = 0;
+        runChunks([this](int begin, int end) {
+            TRACE_SCOPE("updateVision chunk");
+            int rayCastCount = 0;
+            for(int i = begin; i < end; i++) {
+                if(m_agents.aiActive[i])
+                    rayCastCount += m_circles[i].updateVision(m_world, m_settings.vision, getFrameArena());
+                else
+                    m_agents.visibleAgents[i] = {}; // Un bot inactif ne regarde pas
+            }
+            m_rayCastCount.fetch_add(rayCastCount, std::memory_order_relaxed); // Une fois par morceau, pas par cercle
+        });
+    }
+
+    // Décision
+    {
+        ScopedTimer timer(m_profiler, ProfilePhase::Decision);
+        TRACE_SCOPE("decision");
+        m_decisionCount = 0;
+        if(m_replayLog && m_replayLog->readTick(m_agents.controls)) {
+            // Les décisions ne tournent pas : seul le log sait quels bots elles ont mis au repos
+            for(int id = 0; id < m_agents.size(); id++) {
+                if(m_agents.controls[id] & AgentStore::IDLE_CONTROL)
+                    m_agents.aiActive[id] = 0;
+            }
+        }
+        else {
+            runDecisions(input);
+            if(m_settings.hasPlayer && !m_circles.empty())
+                m_agents.controls[0] = (std::uint8_t)input.playerControl.to_ulong();
+        }
+        if(m_recordLog)
+            m_recordLog->recordTick(m_agents.controls);
+    }
+
+    // Action
+    {
+        ScopedTimer timer(m_profiler, ProfilePhase::ApplyControl);
+        TRACE_SCOPE("applyControl");
+        for(Circle& circle : m_circles)
+            circle.applyControl(std::bitset<4>(m_agents.controls[circle.m_instanceID] & AgentStore::DIRECTION_MASK));
+    }
+
+    {
+        TRACE_SCOPE("b2World::Step");
+        AllocationScope allocations; // Box2D n'a pas de ScopedTimer : ses temps viennent de b2Profile
+        m_contactListener.beginStep(getFrameArena(), CONTACT_EVENTS_PER_CIRCLE * (int)m_circles.size() + 64);
+        m_world.Step(m_settings.timeStep, m_settings.velocityIterations, m_settings.positionIterations);
+        m_contactListener.endStep();
+        if(m_profiler)
+            m_profiler->addAllocations(ProfilePhase::WorldStep, allocations.getCounts());
+    }
+    applyContactDamage();
+    m_tickCount++;
+    {
+        TRACE_SCOPE("sync and grid");
+        m_agents.syncFromBodies();
+        rebuildGrid();
+    }
+    updateAggro();
+    updateActivity();
+    if(m_profiler)
+        recordProfile();
+
+    if(m_winnerID < 0) {
+        b2Vec2 target(input.botTarget.x / SCALE, input.botTarget.y / SCALE);
+        int winnerID = -1;
+        m_grid.forEachInRadius(target, m_settings.circleRadius / SCALE, SpatialGrid::ANY_TEAM, [&](int id, b2Vec2) {
+            if(winnerID < 0 || id < winnerID)
+                winnerID = id;
+        });
+        m_winnerID = winnerID;
+    }
+}
+
+/**
+ * @brief Applies the collision damage of the last world step, from its contact events.
+ *
+ * Each solver impulse between circles of different teams costs both of them contactDamage
+ * health per N·s. Health stops at 0.
+ */
+void Simulation::applyContactDamage() {
+    if(m_settings.contactDamage <= 0.f)
+        return;
+    for(const ContactEvent& event : m_contactListener.getEvents()) {
+        if(event.type != ContactEvent::Type::Hit || event.agentA < 0 || event.agentB < 0)
+            continue;
+        if(m_agents.team[event.agentA] == m_agents.team[event.agentB])
+            continue;
+        float damage = event.impulse * m_settings.contactDamage;
+        for(int id : { event.agentA, event.agentB }) {
+            bool wasAlive = m_agents.health[id] > 0.f;
+            m_agents.health[id] = std::max(0.f, m_agents.health[id] - damage);
+            // TeamContactFilter n'est consulté qu'à la création des paires : on refiltre le mort
+            if(wasAlive && m_agents.health[id] <= 0.f && m_settings.useContactFilter) {
+                for(b2Fixture* fixture = m_agents.bodies[id]->GetFixtureList(); fixture; fixture = fixture->GetNext())
+                    fixture->Refilter();
+            }
+        }
+    }
+}
+
+/**
+ * @brief Updates the aggro target of the circles from the sensor events of the last world step.
+ *
+ * A circle keeps the first enemy that entered its aggro radius. When that one leaves while others
+ * are still inside, the nearest of them is looked up in the grid, once, instead of scanning every tick.
+ */
+void Simulation::updateAggro() {
+    if(m_settings.aggroRadius <= 0.f)
+        return;
+    for(const ContactEvent& event : m_contactListener.getEvents()) {
+        int id = event.agentA;
+        if(event.type == ContactEvent::Type::AggroEnter) {
+            m_agents.aggroCount[id]++;
+            if(m_agents.aggroTarget[id] < 0)
+                m_agents.aggroTarget[id] = event.agentB;
+        }
+        else if(event.type == ContactEvent::Type::AggroExit) {
+            m_agents.aggroCount[id]--;
+            if(m_agents.aggroTarget[id] != event.agentB)
+                continue;
+            m_agents.aggroTarget[id] = -1;
+            if(m_agents.aggroCount[id] > 0) {
+                // Le capteur touche le cercle ennemi : centres à moins de aggroRadius + rayon
+                b2Vec2 position(m_agents.positionX[id], m_agents.positionY[id]);
+                float radius = (m_settings.aggroRadius + m_settings.circleRadius) / SCALE;
+                m_agents.aggroTarget[id] = m_grid.findNearest(position, m_agents.team[id], radius);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Wakes the idle bots touched or approached during the last world step, or whose timer is up,
+ * and puts the bodies of the idle bots to sleep once they have slowed down.
+ *
+ * An active bot whose body fell asleep goes idle too. Box2D's own sleep tolerances are compile-time constants of the library, tuned for undamped
+ * bodies; the idle bots are put to sleep here as soon as the damping has nearly stopped them.
+ */
+void Simulation::updateActivity() {
+    if(!m_settings.aiSleep)
+        return;
+    auto wake = [this](int id) {
+        m_agents.aiActive[id] = 1;
+        m_agents.controls[id] = 0; // Sans IDLE_CONTROL, qui le remettrait au repos au replay s'il n'est pas décidé au tick suivant
+        m_agents.decisionDue[id] = 1; // Réagit dès le tick suivant, sans attendre son créneau
+        m_agents.bodies[id]->SetAwake(true); // Sinon la règle du corps endormi le rendormirait aussitôt
+    };
+    for(const ContactEvent& event : m_contactListener.getEvents()) {
+        if(event.type != ContactEvent::Type::Begin && event.type != ContactEvent::Type::AggroEnter)
+            continue;
+        for(int id : { event.agentA, event.agentB }) {
+            if(id >= 0 && !m_agents.aiActive[id])
+                wake(id);
+        }
+    }
+
+    int wakePeriod = std::max(1, m_settings.aiWakePeriod);
+    for(int id = 0; id < m_agents.size(); id++) {
+        if(m_agents.aiActive[id]) {
+            // Un bot actif dont le corps dort n'a rien fait depuis b2_timeToSleep : il attendra son minuteur
+            if(!m_agents.bodies[id]->IsAwake() && !(m_settings.hasPlayer && id == 0)) {
+                m_agents.aiActive[id] = 0;
+                m_agents.controls[id] = 0; // Les commandes gardées entre deux décisions le réveilleraient
+            }
+            continue;
+        }
+        if((m_tickCount + id) % wakePeriod == 0) { // Décalé d'un bot à l'autre : pas de réveil en masse
+            wake(id);
+            continue;
+        }
+        b2Body* body = m_agents.bodies[id];
+        float speedSquared = m_agents.velocityX[id] * m_agents.velocityX[id] + m_agents.velocityY[id] * m_agents.velocityY[id];
+        if(m_settings.allowSleeping && body->IsAwake() && speedSquared < IDLE_SLEEP_SPEED * IDLE_SLEEP_SPEED
+           && std::abs(m_agents.angularVelocity[id]) < IDLE_SLEEP_ANGULAR_SPEED)
+            body->SetAwake(false);
+    }
+}
+
+/**
+ * @brief Records the Box2D timings and the counters of the tick that just ended.
+ */
+void Simulation::recordProfile() {
+    m_profiler->addWorldProfile(m_world.GetProfile());
+
+    int awakeBodies = 0;
+    for(const b2Body* body = m_world.GetBodyList(); body; body = body->GetNext()) {
+        if(body->GetType() != b2_staticBody && body->IsAwake())
+            awakeBodies++;
+    }
+    int contacts = 0;
+    for(const b2Contact* contact = m_world.GetContactList(); contact; contact = contact->GetNext()) {
+        if(contact->IsTouching())
+            contacts++;
+    }
+    m_profiler->addCount(ProfileCounter::AwakeBodies, (float)awakeBodies);
+    m_profiler->addCount(ProfileCounter::Contacts, (float)contacts);
+    m_profiler->addCount(ProfileCounter::RayCasts, (float)(m_settings.visionEnabled ? m_rayCastCount.load() : 0));
+    m_profiler->addCount(ProfileCounter::ContactEvents, (float)m_contactListener.getEvents().size());
+    int activeBots = 0;
+    for(std::uint8_t active : m_agents.aiActive)
+        activeBots += active;
+    m_profiler->addCount(ProfileCounter::ActiveBots, (float)activeBots);
+    m_profiler->addCount(ProfileCounter::Decisions, (float)m_decisionCount.load());
+}
+
+/**
+ * @brief Computes the controls of the bots in [begin, end).
+ *
+ * Only the bots due are decided, the others hold their controls. The active ones are gathered into
+ * arrays of the frame arena and go through Steering together; the idle ones get no control at all,
+ * so that their bodies come to rest. A bot that finds no target goes idle; its controls get
+ * AgentStore::IDLE_CONTROL, so that a replay, which skips the decisions, idles it on the same tick.
+ * @param begin The first circle ID.
+ * @param end One past the last circle ID.
+ * @param input The inputs of the tick.
+ * @return The number of bots decided.
+ */
+int Simulation::decideChunk(int begin, int end, const TickInput& input) {
+    FrameArena& arena = getFrameArena(); // Rien ne survit au tick
+    int count = end - begin;
+    int* ids = arena.allocate<int>(count);
+    float* positionX = arena.allocate<float>(count);
+    float* positionY = arena.allocate<float>(count);
+    float* angle = arena.allocate<float>(count);
+    float* velocityX = arena.allocate<float>(count);
+    float* velocityY = arena.allocate<float>(count);
+    float* targetX = arena.allocate<float>(count);
+    float* targetY = arena.allocate<float>(count);
+    std::uint8_t* controls = arena.allocate<std::uint8_t>(count);
+
+    int activeCount = 0, decisionCount = 0;
+    for(int i = begin; i < end; i++) {
+        if(!m_agents.decisionDue[i])
+            continue; // Garde sa dernière commande
+        m_agents.decisionDue[i] = 0;
+        decisionCount++;
+        sf::Vector2f target;
+        bool isPlayer = m_settings.hasPlayer && i == 0;
+        if(!m_agents.aiActive[i] || (!chooseTarget(m_circles[i], input, target) && m_settings.aiSleep && !isPlayer)) {
+            m_agents.aiActive[i] = 0;
+            m_agents.controls[i] = AgentStore::IDLE_CONTROL; // Aucune direction, et le replay saura qu'il s'est mis au repos
+            continue;
+        }
+        int k = activeCount++;
+        ids[k] = i;
+        positionX[k] = m_agents.positionX[i];
+        positionY[k] = m_agents.positionY[i];
+        angle[k] = m_agents.angle[i];
+        velocityX[k] = m_agents.velocityX[i];
+        velocityY[k] = m_agents.velocityY[i];
+        targetX[k] = target.x / SCALE;
+        targetY[k] = target.y / SCALE;
+    }
+
+    // Tous les bots actifs du morceau d'un coup, au lieu de Circle::botControl() un par un
+    Steering::computeBotControls(positionX, positionY, angle, velocityX, velocityY, targetX, targetY, controls, activeCount);
+    for(int k = 0; k < activeCount; k++)
+        m_agents.controls[ids[k]] = controls[k];
+    return decisionCount;
+}
+
+/**
+ * @brief Picks the position a bot steers toward.
+ * @param circle The bot.
+ * @param input The inputs of the tick.
+ * @param target Receives the target in pixels when bots chase enemies: the aggro target if circles have an
+ * aggro sensor, the nearest enemy in range otherwise. TickInput::botTarget when there is none or bots do not chase.
+ * @return False if the bot chases enemies and none is in range.
+ */
+bool Simulation::chooseTarget(const Circle& circle, const TickInput& input, sf::Vector2f& target) const {
+    target = input.botTarget;
+    if(!m_settings.botsChaseEnemies)
+        return true;
+
+    int enemy;
+    if(m_settings.aggroRadius > 0.f)
+        enemy = m_agents.aggroTarget[circle.m_instanceID]; // Tenu à jour par les capteurs, pas de recherche
+    else {
+        b2Vec2 position(m_agents.positionX[circle.m_instanceID], m_agents.positionY[circle.m_instanceID]);
+        enemy = m_grid.findNearest(position, circle.getTeam(), m_settings.chaseRange / SCALE);
+    }
+    if(enemy < 0)
+        return false;
+    target = m_circles[enemy].getPosition();
+    return true;
+}
+
+/**
+ * @brief Records the controls of every tick from now on.
+ * @param log The log to fill, restarted with the seed of the simulation. nullptr stops recording.
+ */
+void Simulation::setRecordLog(InputLog* log) {
+    m_recordLog = log;
+    if(m_recordLog)
+        m_recordLog->startRecording(m_settings, (int)m_circles.size());
+}
+
+/**
+ * @brief Replays recorded controls instead of reading the inputs and running the bots.
+ *
+ * The simulation must have been built with the settings of the log, see InputLog::getSettings().
+ * Once the log is exhausted, the simulation goes back to its inputs and bots.
+ * @param log The log to replay, rewound to its first tick. nullptr stops replaying.
+ */
+void Simulation::setReplayLog(InputLog* log) {
+    m_replayLog = log;
+    if(m_replayLog)
+        m_replayLog->startReplay();
+}
+
+/**
+ * @brief Copies the state of every dynamic body and circle into a snapshot.
+ *
+ * Reusing the same snapshot object allocates nothing after the first call.
+ * @param snapshot Receives the state.
+ */
+void Simulation::saveSnapshot(SimulationSnapshot& snapshot) const {
+    snapshot.circles.resize(m_circles.size());
+    for(const Circle& circle : m_circles)
+        circle.saveState(snapshot.circles[circle.m_instanceID]);
+    snapshot.tickCount = m_tickCount;
+    snapshot.winnerID = m_winnerID;
+    snapshot.decisionCursor = m_decisionCursor;
+    snapshot.rng = m_rng;
+}
+
+/**
+ * @brief Puts the simulation back in a state saved by saveSnapshot(), without rebuilding the world.
+ *
+ * Box2D's contact cache (warm starting impulses) is not part of the snapshot, so a restored
+ * simulation can drift slightly from the original one after the first collisions.
+ * Recording and replay logs are not rewound.
+ * @param snapshot The state to restore, taken from this simulation.
+ */
+void Simulation::restoreSnapshot(const SimulationSnapshot& snapshot) {
+    assert(snapshot.circles.size() == m_circles.size());
+    for(Circle& circle : m_circles)
+        circle.restoreState(snapshot.circles[circle.m_instanceID]);
+    m_tickCount = snapshot.tickCount;
+    m_winnerID = snapshot.winnerID;
+    m_decisionCursor = snapshot.decisionCursor;
+    m_rng = snapshot.rng;
+    rebuildGrid();
+}
+
+/**
+ * @class RenderQueryCallback
+ * @brief Copies the circles and the walls touching the queried area into a render snapshot.
+ */
+class RenderQueryCallback : public b2QueryCallback {
+public:
+    const AgentStore* m_agents;
+    const std::vector<Wall>* m_walls;
+    RenderSnapshot* m_snapshot;
+
+    bool ReportFixture(b2Fixture* fixture) override {
+        if(fixture->IsSensor())
+            return true;
+        const b2Body* body = fixture->GetBody();
+        int id = Circle::getCircleID(body);
+        if(id < 0) {
+            for(const Wall& wall : *m_walls) {
+                if(wall.getBody() == body)
+                    m_snapshot->walls.push_back(wall.getArea());
+            }
+            return true;
+        }
+
+        RenderAgent agent;
+        agent.previousPosition = sf::Vector2f(m_agents->previousX[id] * SCALE, m_agents->previousY[id] * SCALE);
+        agent.position = sf::Vector2f(m_agents->positionX[id] * SCALE, m_agents->positionY[id] * SCALE);
+        agent.previousAngle = m_agents->previousAngle[id];
+        agent.angle = m_agents->angle[id];
+        agent.radius = m_agents->radius[id];
+        agent.color = Circle::getTeamColor(m_agents->team[id]);
+        m_snapshot->agents.push_back(agent);
+        return true;
+    }
+};
+
+/**
+ * @brief Copies what is needed to draw the circles and the walls in an area, see SimulationThread.
+ *
+ * Only the bodies whose AABB touches the area are copied, found through the Box2D broadphase:
+ * the cost follows what is on screen, not the size of the arena.
+ * Reusing the same snapshot object allocates nothing once the most crowded area has been seen.
+ * @param snapshot Receives the drawable state.
+ * @param area The area to draw, in pixels, usually Camera::getVisibleArea().
+ */
+void Simulation::saveRenderSnapshot(RenderSnapshot& snapshot, const sf::FloatRect& area) const {
+    snapshot.agents.clear(); // Garde la mémoire
+    snapshot.walls.clear();
+    RenderQueryCallback query;
+    query.m_agents = &m_agents;
+    query.m_walls = &m_walls;
+    query.m_snapshot = &snapshot;
+    // La ligne de direction dépasse du cercle, et la vue bouge un peu entre deux publications
+    float margin = RENDER_MARGIN_RADII * m_settings.circleRadius;
+    b2AABB aabb;
+    aabb.lowerBound.Set((area.left - margin) / SCALE, (area.top - margin) / SCALE);
+    aabb.upperBound.Set((area.left + area.width + margin) / SCALE, (area.top + area.height + margin) / SCALE);
+    m_world.QueryAABB(&query, aabb);
+
+    snapshot.tickCount = m_tickCount;
+}
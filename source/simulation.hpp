@@ -0,0 +1,303 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <box2d/box2d.h>
+#include <algorithm>
+#include <bitset>
+#include <atomic>
+#include <cassert>
+#include <functional>
+#include <random>
+#include <vector>
+
+#include "agent_store.hpp"
+#include "allocation_tracker.hpp"
+#include "circle.hpp"
+#include "collision_filter.hpp"
+#include "contact_listener.hpp"
+#include "wall.hpp"
+#include "input_log.hpp"
+#include "profiler.hpp"
+#include "render_snapshot.hpp"
+#include "spatial_grid.hpp"
+#include "steering.hpp"
+#include "thread_pool.hpp"
+#include "trace.hpp"
+#include "constants.hpp"
+#include "frame_arena.hpp"
+#include "simulation_settings.hpp"
+
+/**
+ * @struct TickInput
+ * @brief Everything the simulation needs from the outside world for one tick.
+ */
+struct TickInput {
+    sf::Vector2f botTarget; // Position the bots steer toward, in pixels
+    std::bitset<4> playerControl; // Controls of the player circle, indexed by Circle::Direction
+};
+
+/**
+ * @struct SimulationSnapshot
+ * @brief Flat copy of the dynamic state of a simulation, see Simulation::saveSnapshot().
+ */
+struct SimulationSnapshot {
+    std::vector<CircleState> circles; // Indexed by circle ID
+    long long tickCount{ 0 };
+    int winnerID{ -1 };
+    int decisionCursor{ 0 };
+    std::mt19937 rng;
+};
+
+/**
+ * @class Simulation
+ * @brief Owns the Box2D world, the walls and the circles, and advances the battle tick by tick.
+ *
+ * The simulation never touches a window: inputs are passed as data, so it can run headless.
+ */
+class Simulation {
+private:
+    SimulationSettings m_settings;
+    std::mt19937 m_rng; // Owned by the simulation so that several simulations can run side by side
+    ContactListener m_contactListener; // Before m_world, which keeps a pointer to it
+    b2World m_world;
+    std::vector<Wall> m_walls;
+    AgentStore m_agents; // State of the circles, indexed by circle ID
+    std::vector<Circle> m_circles; // Handles into m_agents
+    TeamContactFilter m_contactFilter{ m_agents }; // Installed if SimulationSettings::useContactFilter
+    SpatialGrid m_grid; // Circle centres at the end of the last tick
+    std::vector<FrameArena> m_frameArenas; // Scratch data of the tick, one per thread of the pool, reset by step()
+    InputLog* m_recordLog{ nullptr };
+    InputLog* m_replayLog{ nullptr };
+    ThreadPool* m_threadPool{ nullptr };
+    Profiler* m_profiler{ nullptr };
+    std::atomic<int> m_rayCastCount{ 0 }; // Vision rays of the current tick, summed over the chunks
+    std::atomic<int> m_decisionCount{ 0 }; // Bots decided during the current tick
+    int m_decisionCursor{ 0 }; // Circle ID the next decision round starts from
+    long long m_tickCount{ 0 };
+    int m_winnerID{ -1 }; // ID of the first circle that reached the bot target, -1 while nobody did
+
+    /**
+     * @brief Runs a phase over ranges of circle IDs, split across the thread pool if there is one.
+     * @param phase The work of the circles in [begin, end). It may only write to the slots of those circles.
+     */
+    void runChunks(const std::function<void(int begin, int end)>& phase);
+
+    /**
+     * @brief Runs a phase over ranges of the circle IDs in [first, last), split across the thread pool if there is one.
+     * @param first The first circle ID.
+     * @param last One past the last circle ID.
+     * @param phase The work of the circles in [begin, end). It may only write to the slots of those circles.
+     */
+    void runChunks(int first, int last, const std::function<void(int begin, int end)>& phase);
+
+    /**
+     * @brief Marks the bots whose decision slot is this tick, then decides the bots due, within the AI budget.
+     *
+     * With a decision rate, bot i has its slot every period ticks, shifted by i, so that each tick
+     * decides about the same number of bots; the others keep their last controls. The bots due are
+     * decided in rounds from m_decisionCursor on, wrapping around: once the budget is spent, the
+     * rounds stop and the bots still due are the first decided next tick.
+     * @param input The inputs of the tick.
+     */
+    void runDecisions(const TickInput& input);
+
+    /**
+     * @brief Rebuilds the spatial grid over the current circle centres.
+     */
+    void rebuildGrid();
+
+    /**
+     * @brief Gets the frame arena of the calling thread: its index in the pool of the simulation, see ThreadPool::getThreadIndex().
+     * Arena 0 without a pool, or for a thread outside it (e.g. a Simulation built on a worker of the BatchRunner pool).
+     */
+    FrameArena& getFrameArena() {
+        int index = m_threadPool ? m_threadPool->getThreadIndex() : 0;
+        assert(index < (int)m_frameArenas.size());
+        return m_frameArenas[index];
+    }
+
+    /**
+     * @brief Records the Box2D timings and the counters of the tick that just ended.
+     */
+    void recordProfile();
+
+    /**
+     * @brief Applies the collision damage of the last world step, from its contact events.
+     */
+    void applyContactDamage();
+
+    /**
+     * @brief Updates the aggro target of the circles from the sensor events of the last world step.
+     */
+    void updateAggro();
+
+    /**
+     * @brief Runs the phases of one tick, see step().
+     * @param input The inputs for this tick.
+     */
+    void stepPhases(const TickInput& input);
+
+    /**
+     * @brief Picks the position a bot steers toward.
+     * @param circle The bot.
+     * @param input The inputs of the tick.
+     * @param target Receives the target in pixels when bots chase enemies: the aggro target if circles have an
+     * aggro sensor, the nearest enemy in range otherwise. TickInput::botTarget when there is none or bots do not chase.
+     * @return False if the bot chases enemies and none is in range.
+     */
+    bool chooseTarget(const Circle& circle, const TickInput& input, sf::Vector2f& target) const;
+
+    /**
+     * @brief Computes the controls of the bots in [begin, end).
+     *
+     * Only the bots due are decided, the others hold their controls. The active ones are gathered into
+     * arrays of the frame arena and go through Steering together; the idle ones get no control at all,
+     * so that their bodies come to rest. A bot that finds no target goes idle; its controls get
+     * AgentStore::IDLE_CONTROL, so that a replay, which skips the decisions, idles it on the same tick.
+     * @param begin The first circle ID.
+     * @param end One past the last circle ID.
+     * @param input The inputs of the tick.
+     * @return The number of bots decided.
+     */
+    int decideChunk(int begin, int end, const TickInput& input);
+
+    /**
+     * @brief Wakes the idle bots touched or approached during the last world step, or whose timer is up,
+     * and puts the bodies of the idle bots to sleep once they have slowed down.
+     */
+    void updateActivity();
+
+public:
+    /**
+     * @brief Constructs the arena: four walls around SimulationSettings::arenaSize and the circles at random positions.
+     * @param settings The simulation parameters.
+     */
+    explicit Simulation(const SimulationSettings& settings = SimulationSettings());
+
+    Simulation(const Simulation&) = delete;
+    Simulation& operator=(const Simulation&) = delete;
+
+    /**
+     * @brief Advances the simulation by one tick: controls every circle then steps the world.
+     *
+     * The tick runs in phases. The world is only read during perception (vision) and decision
+     * (bots, batched by Steering), which run in parallel with one result slot per circle; the forces are then applied
+     * on the calling thread before the world step.
+     * The first circle whose centre gets within one radius of the bot target wins the battle.
+     * Once the buffers have grown during the first ticks, a tick makes no heap allocation, which
+     * Debug builds assert (recording and tracing excepted: their buffers grow on purpose).
+     * @param input The inputs for this tick.
+     */
+    void step(const TickInput& input);
+
+    /**
+     * @brief Runs the perception and decision phases on a thread pool.
+     * @param threadPool The pool, nullptr runs everything on the calling thread.
+     */
+    void setThreadPool(ThreadPool* threadPool);
+
+    /**
+     * @brief Times the phases of every tick and counts awake bodies, contacts and vision rays.
+     * @param profiler The profiler, used from the thread calling step(). nullptr stops profiling.
+     */
+    void setProfiler(Profiler* profiler) { m_profiler = profiler; }
+
+    /**
+     * @brief Sets the iterations of the Box2D solver from the next tick on. Fewer iterations are cheaper but let
+     * the bodies overlap more.
+     * @param velocityIterations The velocity iterations.
+     * @param positionIterations The position iterations.
+     */
+    void setSolverIterations(int velocityIterations, int positionIterations) {
+        m_settings.velocityIterations = velocityIterations;
+        m_settings.positionIterations = positionIterations;
+    }
+
+    /**
+     * @brief Sets VisionSettings::maxRays from the next tick on.
+     * @param maxRays The rays cast per circle and tick, 0 for no limit.
+     */
+    void setVisionRayLimit(int maxRays) { m_settings.vision.maxRays = maxRays; }
+
+    /**
+     * @brief Sets SimulationSettings::aiDecisionRate from the next tick on.
+     * @param rate The decisions per second of each bot, 0 decides every tick.
+     */
+    void setAiDecisionRate(float rate) { m_settings.aiDecisionRate = rate; }
+
+    /**
+     * @brief Gets the timings Box2D measured during the last world step.
+     */
+    const b2Profile& getWorldProfile() const { return m_world.GetProfile(); }
+
+    /**
+     * @brief Gets the spatial grid over the circle centres, rebuilt at the end of every tick.
+     *
+     * Neighbour queries (enemies within a radius, nearest enemy...) should go through it rather
+     * than through the circle list. The point indices are circle IDs and the teams are circle teams.
+     */
+    const SpatialGrid& getGrid() const { return m_grid; }
+
+    /**
+     * @brief Gets the state of the circles, one array per field, indexed by circle ID.
+     */
+    const AgentStore& getAgents() const { return m_agents; }
+
+    /**
+     * @brief Gets the collisions of the last tick: contacts begun and ended, and impulses of the solver.
+     *
+     * Game systems should read them here, in one batch, rather than walk the contact list of each body.
+     * Only valid until the next tick starts.
+     */
+    std::span<const ContactEvent> getContactEvents() const { return m_contactListener.getEvents(); }
+
+    /**
+     * @brief Records the controls of every tick from now on.
+     * @param log The log to fill, restarted with the seed of the simulation. nullptr stops recording.
+     */
+    void setRecordLog(InputLog* log);
+
+    /**
+     * @brief Replays recorded controls instead of reading the inputs and running the bots.
+     *
+     * The simulation must have been built with the settings of the log, see InputLog::getSettings().
+     * Once the log is exhausted, the simulation goes back to its inputs and bots.
+     * @param log The log to replay, rewound to its first tick. nullptr stops replaying.
+     */
+    void setReplayLog(InputLog* log);
+
+    /**
+     * @brief Copies the state of every dynamic body and circle into a snapshot.
+     *
+     * Reusing the same snapshot object allocates nothing after the first call.
+     * @param snapshot Receives the state.
+     */
+    void saveSnapshot(SimulationSnapshot& snapshot) const;
+
+    /**
+     * @brief Puts the simulation back in a state saved by saveSnapshot(), without rebuilding the world.
+     *
+     * Box2D's contact cache (warm starting impulses) is not part of the snapshot, so a restored
+     * simulation can drift slightly from the original one after the first collisions.
+     * Recording and replay logs are not rewound.
+     * @param snapshot The state to restore, taken from this simulation.
+     */
+    void restoreSnapshot(const SimulationSnapshot& snapshot);
+
+    /**
+     * @brief Copies what is needed to draw the circles and the walls in an area, see SimulationThread.
+     *
+     * Only the bodies whose AABB touches the area are copied, found through the Box2D broadphase:
+     * the cost follows what is on screen, not the size of the arena.
+     * Reusing the same snapshot object allocates nothing once the most crowded area has been seen.
+     * @param snapshot Receives the drawable state.
+     * @param area The area to draw, in pixels, usually Camera::getVisibleArea().
+     */
+    void saveRenderSnapshot(RenderSnapshot& snapshot, const sf::FloatRect& area) const;
+
+    const SimulationSettings& getSettings() const { return m_settings; }
+    long long getTickCount() const { return m_tickCount; }
+    int getCircleCount() const { return (int)m_circles.size(); }
+    int getWinnerID() const { return m_winnerID; }
+    bool isFinished() const { return m_winnerID >= 0; }
+};
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <SFML/System/Vector2.hpp>
+#include <cstdint>
+
+#include "circle.hpp"
+#include "constants.hpp"
+
+/**
+ * @struct SimulationSettings
+ * @brief Parameters used to build a Simulation.
+ */
+struct SimulationSettings {
+    std::uint32_t seed{ 0 }; // Same seed and same inputs give the same battle
+    int circleCount{ 20 };
+    int teamCount{ 2 }; // Circle i belongs to team i % teamCount
+    float circleRadius{ 20.f };
+    sf::Vector2f arenaSize{ WINDOW_WIDTH, WINDOW_HEIGHT }; // Pixels, walls included. Independent of the window, see Camera
+    bool hasPlayer{ true }; // If true, circle 0 is driven by TickInput::playerControl instead of the bot
+    float timeStep{ 1.f / TICK_RATE }; // Duration of one tick (s)
+    int velocityIterations{ 8 };
+    int positionIterations{ 3 };
+    bool visionEnabled{ true };
+    VisionSettings vision;
+    bool botsChaseEnemies{ false }; // If true, each bot steers toward its nearest enemy instead of TickInput::botTarget
+    float chaseRange{ 2000.f }; // Enemies further than this are ignored, in pixels
+    float contactDamage{ 0.f }; // Health lost per N·s of impulse when two enemies collide, 0 disables damage
+    bool teammatesCollide{ true }; // If false, the circles of a team pass through each other, see CollisionFilter
+    float aggroRadius{ 0.f }; // > 0 gives each circle an aggro sensor of this radius (pixels), chased instead of the nearest enemy
+    bool useContactFilter{ false }; // If true, installs TeamContactFilter: dead circles stop colliding
+    bool allowSleeping{ true }; // Box2D stops simulating the bodies at rest, see b2World::SetAllowSleeping()
+    bool aiSleep{ true }; // If true, bots without a target go idle and skip perception and decision until woken up
+    int aiWakePeriod{ 60 }; // Ticks between two checks of an idle bot for a target, staggered across bots
+    float aiDecisionRate{ 0.f }; // Decisions per second of each bot, staggered across ticks, the controls are held in between. 0 decides every tick
+    float aiBudgetMs{ 0.f }; // > 0 caps the decision phase of a tick (ms), the bots left over go first next tick. Makes runs timing-dependent
+};
@@ -0,0 +1,133 @@
+#include "simulation_thread.hpp"
+
+#include <algorithm>
+
+/**
+ * @brief Prepares the thread and publishes the initial state of the simulation.
+ *
+ * The simulation is profiled for as long as the SimulationThread exists, see RenderSnapshot::profile.
+ * @param simulation The simulation, only touched by the thread between start() and stop().
+ */
+SimulationThread::SimulationThread(Simulation& simulation)
+    : m_simulation(simulation)
+{
+    m_simulation.setProfiler(&m_profiler);
+    // Toute l'arène tant que le thread de rendu n'a pas donné sa vue
+    setViewArea(sf::FloatRect(sf::Vector2f(0.f, 0.f), simulation.getSettings().arenaSize));
+    publishSnapshot();
+}
+
+SimulationThread::~SimulationThread() {
+    stop();
+    m_simulation.setProfiler(nullptr);
+}
+
+/**
+ * @brief Starts ticking the simulation.
+ */
+void SimulationThread::start() {
+    if(m_running.exchange(true))
+        return;
+    m_thread = std::thread(&SimulationThread::run, this);
+}
+
+/**
+ * @brief Stops ticking and waits for the thread. The simulation can then be used again from the caller.
+ */
+void SimulationThread::stop() {
+    m_running = false;
+    if(m_thread.joinable())
+        m_thread.join();
+}
+
+/**
+ * @brief Sets the inputs used from the next tick on.
+ * @param input The inputs.
+ */
+void SimulationThread::setInput(const TickInput& input) {
+    m_targetX.store(input.botTarget.x, std::memory_order_relaxed);
+    m_targetY.store(input.botTarget.y, std::memory_order_relaxed);
+    m_playerControl.store((std::uint8_t)input.playerControl.to_ulong(), std::memory_order_relaxed);
+}
+
+/**
+ * @brief Sets the area the next snapshots are culled to.
+ * @param area The area on screen, in pixels, see Camera::getVisibleArea().
+ */
+void SimulationThread::setViewArea(const sf::FloatRect& area) {
+    m_viewAreas.getWriteBuffer() = area;
+    m_viewAreas.publish();
+}
+
+/**
+ * @brief Gets the latest published snapshot. Render thread only.
+ *
+ * The reference stays valid and unchanged until the next call.
+ */
+const RenderSnapshot& SimulationThread::getLatestSnapshot() {
+    m_snapshots.update();
+    return m_snapshots.getReadBuffer();
+}
+
+void SimulationThread::publishSnapshot() {
+    m_viewAreas.update();
+    RenderSnapshot& snapshot = m_snapshots.getWriteBuffer();
+    {
+        ScopedTimer timer(&m_profiler, ProfilePhase::Snapshot);
+        TRACE_SCOPE("saveRenderSnapshot");
+        m_simulation.saveRenderSnapshot(snapshot, m_viewAreas.getReadBuffer());
+    }
+    m_profiler.saveReport(snapshot.profile);
+    float timeScale = m_timeScale.load(std::memory_order_relaxed);
+    snapshot.timeStep = timeScale > 0.f ? m_simulation.getSettings().timeStep / timeScale : 0.f;
+    snapshot.detailScale = m_governor ? m_governor->getDetailScale() : 1.f;
+    snapshot.publishTime = std::chrono::steady_clock::now();
+    m_snapshots.publish();
+}
+
+void SimulationThread::stepOnce(const TickInput& input) {
+    m_simulation.step(input);
+    if(m_governor && m_governor->update(m_profiler, m_simulation.getWorldProfile(), m_drawMs.load(std::memory_order_relaxed)))
+        m_governor->apply(m_simulation);
+}
+
+void SimulationThread::run() {
+    Trace::setThreadName("simulation");
+    using Clock = std::chrono::steady_clock;
+    const float timeStep = m_simulation.getSettings().timeStep;
+    Clock::time_point nextTick = Clock::now();
+
+    while(m_running.load(std::memory_order_relaxed)) {
+        TickInput input;
+        input.botTarget = sf::Vector2f(m_targetX.load(std::memory_order_relaxed), m_targetY.load(std::memory_order_relaxed));
+        input.playerControl = std::bitset<4>(m_playerControl.load(std::memory_order_relaxed));
+
+        float timeScale = m_timeScale.load(std::memory_order_relaxed);
+        if(timeScale <= 0.f) {
+            // Au plus vite : les ticks s'enchaînent, un état n'est préparé que quand le rendu a pris le précédent
+            stepOnce(input);
+            if(m_snapshots.isTaken())
+                publishSnapshot();
+            nextTick = Clock::now();
+            continue;
+        }
+
+        // Rattrape le retard, mais pas plus de MAX_TICKS_PER_FRAME (fois l'accélération) d'un coup (spirale de la mort)
+        const Clock::duration tickDuration = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<float>(timeStep / timeScale));
+        const int maxTicks = (int)(MAX_TICKS_PER_FRAME * std::max(1.f, timeScale));
+        Clock::time_point now = Clock::now();
+        int ticks = 0;
+        while(nextTick <= now && ticks < maxTicks) {
+            stepOnce(input);
+            nextTick += tickDuration;
+            ticks++;
+        }
+        if(nextTick <= now)
+            nextTick = now; // Trop en retard : on ralentit le jeu plutôt que d'accumuler
+        // En accéléré, plusieurs ticks par image : inutile de copier un état que le rendu sautera
+        if(ticks > 0 && (timeScale <= 1.f || m_snapshots.isTaken()))
+            publishSnapshot();
+
+        std::this_thread::sleep_until(nextTick);
+    }
+}
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+#include "quality_governor.hpp"
+#include "render_snapshot.hpp"
+#include "simulation.hpp"
+#include "triple_buffer.hpp"
+
+/**
+ * @class SimulationThread
+ * @brief Runs a simulation at its tick rate on its own thread, so that rendering never stalls the physics.
+ *
+ * After each burst of ticks the thread publishes a RenderSnapshot through a lock-free triple buffer.
+ * The render thread passes its inputs through atomics and its view area through a second triple
+ * buffer, and draws the latest snapshot: a 16 ms frame and a 10 ms tick overlap instead of adding
+ * up. Neither side takes a lock. Snapshots only hold what is in the view area.
+ * When fast-forwarding, several ticks run per frame and a snapshot is only prepared once the render
+ * thread has taken the previous one: the ticks nobody would see are never copied.
+ */
+class SimulationThread {
+private:
+    Simulation& m_simulation;
+    TripleBuffer<RenderSnapshot> m_snapshots;
+    TripleBuffer<sf::FloatRect> m_viewAreas; // Written by the render thread
+    std::atomic<float> m_targetX{ 0.f }; // TickInput written by the render thread
+    std::atomic<float> m_targetY{ 0.f };
+    std::atomic<std::uint8_t> m_playerControl{ 0 };
+    std::atomic<float> m_timeScale{ 1.f }; // Written by the render thread, see setTimeScale()
+    std::atomic<float> m_drawMs{ 0.f }; // Written by the render thread, read by the governor
+    Profiler m_profiler; // Simulation thread only
+    QualityGovernor* m_governor{ nullptr }; // Simulation thread only once started
+    std::atomic<bool> m_running{ false };
+    std::thread m_thread;
+
+    void run();
+    void stepOnce(const TickInput& input);
+    void publishSnapshot();
+
+public:
+    /**
+     * @brief Prepares the thread and publishes the initial state of the simulation.
+     *
+     * The simulation is profiled for as long as the SimulationThread exists, see RenderSnapshot::profile.
+     * @param simulation The simulation, only touched by the thread between start() and stop().
+     */
+    explicit SimulationThread(Simulation& simulation);
+    ~SimulationThread();
+
+    SimulationThread(const SimulationThread&) = delete;
+    SimulationThread& operator=(const SimulationThread&) = delete;
+
+    /**
+     * @brief Starts ticking the simulation.
+     */
+    void start();
+
+    /**
+     * @brief Stops ticking and waits for the thread. The simulation can then be used again from the caller.
+     */
+    void stop();
+
+    /**
+     * @brief Sets the inputs used from the next tick on.
+     * @param input The inputs.
+     */
+    void setInput(const TickInput& input);
+
+    /**
+     * @brief Sets the area the next snapshots are culled to.
+     * @param area The area on screen, in pixels, see Camera::getVisibleArea().
+     */
+    void setViewArea(const sf::FloatRect& area);
+
+    /**
+     * @brief Sets the speed of the simulation from the next ticks on.
+     * @param timeScale Simulated seconds per real second, e.g. 10 for ten times faster. 0 runs the ticks back to back,
+     * as fast as possible.
+     */
+    void setTimeScale(float timeScale) { m_timeScale.store(timeScale, std::memory_order_relaxed); }
+
+    /**
+     * @brief Lets a governor adjust the quality of the simulation after every tick, see QualityGovernor.
+     * The tessellation it picks is published in RenderSnapshot::detailScale.
+     * @param governor The governor, nullptr keeps the settings of the simulation. Only call it before start().
+     */
+    void setQualityGovernor(QualityGovernor* governor) { m_governor = governor; }
+
+    /**
+     * @brief Reports how long the render thread took to prepare and draw its last frame, for the governor.
+     * @param milliseconds The draw time, in ms.
+     */
+    void setDrawTime(float milliseconds) { m_drawMs.store(milliseconds, std::memory_order_relaxed); }
+
+    /**
+     * @brief Gets the latest published snapshot. Render thread only.
+     *
+     * The reference stays valid and unchanged until the next call.
+     */
+    const RenderSnapshot& getLatestSnapshot();
+};
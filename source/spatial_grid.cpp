@@ -0,0 +1,160 @@
+#include "spatial_grid.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+/**
+ * @brief Rebuilds the grid over a set of points.
+ * @param positionX The x coordinate of each point, in meters.
+ * @param positionY The y coordinate of each point, in meters.
+ * @param teams The team of each point.
+ * @param cellSize The side of a cell, in meters. One circle diameter is a good choice.
+ */
+void SpatialGrid::build(const std::vector<float>& positionX, const std::vector<float>& positionY,
+                        const std::vector<std::uint8_t>& teams, float cellSize) {
+    int count = (int)positionX.size();
+    m_cellSize = cellSize;
+    m_inverseCellSize = 1.f / cellSize;
+
+    // Au moins deux buckets par point pour limiter les collisions
+    std::uint32_t bucketCount = 1;
+    while(bucketCount < 2u * (std::uint32_t)count)
+        bucketCount <<= 1;
+    m_bucketMask = bucketCount - 1;
+
+    // Tri par comptage : taille de chaque bucket, puis début de chaque bucket
+    m_bucketStarts.assign(bucketCount + 1, 0);
+    m_pointBuckets.resize(count);
+    m_minCellX = m_minCellY = std::numeric_limits<int>::max();
+    m_maxCellX = m_maxCellY = std::numeric_limits<int>::min();
+    for(int i = 0; i < count; i++) {
+        int x = cellCoord(positionX[i]), y = cellCoord(positionY[i]);
+        m_minCellX = std::min(m_minCellX, x);
+        m_maxCellX = std::max(m_maxCellX, x);
+        m_minCellY = std::min(m_minCellY, y);
+        m_maxCellY = std::max(m_maxCellY, y);
+        m_pointBuckets[i] = bucketOf(x, y);
+        m_bucketStarts[m_pointBuckets[i] + 1]++;
+    }
+    for(std::uint32_t bucket = 0; bucket < bucketCount; bucket++)
+        m_bucketStarts[bucket + 1] += m_bucketStarts[bucket];
+
+    m_entryIndices.resize(count);
+    m_entryPositions.resize(count);
+    m_entryTeams.resize(count);
+    m_entryCells.resize(count);
+    // Remplit chaque bucket à partir de sa fin, m_pointBuckets sert de curseur
+    for(int i = count - 1; i >= 0; i--) {
+        int entry = --m_bucketStarts[m_pointBuckets[i] + 1];
+        m_entryIndices[entry] = i;
+        m_entryPositions[entry].Set(positionX[i], positionY[i]);
+        m_entryTeams[entry] = teams[i];
+        m_entryCells[entry] = cellKey(cellCoord(positionX[i]), cellCoord(positionY[i]));
+    }
+    // Après la boucle, m_bucketStarts[b + 1] pointe sur le début du bucket b : on décale d'un cran
+    for(std::uint32_t bucket = 0; bucket < bucketCount; bucket++)
+        m_bucketStarts[bucket] = m_bucketStarts[bucket + 1];
+    m_bucketStarts[bucketCount] = count;
+}
+
+/**
+ * @brief Tells whether the square of cells at Chebyshev distance <= ring from a cell covers every point.
+ */
+bool SpatialGrid::coversAllCells(int x, int y, int ring) const {
+    return x - ring <= m_minCellX && x + ring >= m_maxCellX && y - ring <= m_minCellY && y + ring >= m_maxCellY;
+}
+
+/**
+ * @brief Collects the points within a radius of a centre ("enemies within R").
+ * @param center The centre, in meters.
+ * @param radius The radius, in meters.
+ * @param team Only points of another team are returned, ANY_TEAM returns them all.
+ * @param out Receives the point indices, in no particular order. Cleared first.
+ * @return The number of points found.
+ */
+int SpatialGrid::queryRadius(b2Vec2 center, float radius, int team, ArenaVector<int>& out) const {
+    out.clear();
+    forEachInRadius(center, radius, team, [&](int index, b2Vec2) {
+        out.push_back(index);
+    });
+    return (int)out.size();
+}
+
+/**
+ * @brief Finds the closest point to a centre ("nearest enemy").
+ *
+ * The cells are visited ring by ring around the centre. Every point beyond ring r is at least
+ * r cells away, so the search stops as soon as the best distance is below that bound.
+ * @param center The centre, in meters.
+ * @param team Only points of another team are considered, ANY_TEAM considers them all.
+ * @param maxRadius Points further than this are ignored, in meters.
+ * @return The point index, -1 if there is none.
+ */
+int SpatialGrid::findNearest(b2Vec2 center, int team, float maxRadius) const {
+    int best = -1;
+    float bestDistanceSquared = maxRadius * maxRadius;
+    int x = cellCoord(center.x), y = cellCoord(center.y);
+
+    for(int ring = 0; ; ring++) {
+        forEachInRing(x, y, ring, [&](int entry) {
+            if(!isEnemy(team, m_entryTeams[entry]))
+                return;
+            float distanceSquared = (m_entryPositions[entry] - center).LengthSquared();
+            if(distanceSquared <= bestDistanceSquared) {
+                bestDistanceSquared = distanceSquared;
+                best = m_entryIndices[entry];
+            }
+        });
+
+        float reach = ring * m_cellSize; // Distance minimale des cellules non visitées
+        if(reach * reach >= bestDistanceSquared || coversAllCells(x, y, ring))
+            return best;
+    }
+}
+
+/**
+ * @brief Finds the k closest points to a centre.
+ * @param center The centre, in meters.
+ * @param k The maximum number of points.
+ * @param team Only points of another team are considered, ANY_TEAM considers them all.
+ * @param maxRadius Points further than this are ignored, in meters.
+ * @param out Receives the point indices, closest first. Cleared first. Its arena also holds the candidates.
+ * @return The number of points found.
+ */
+int SpatialGrid::findKNearest(b2Vec2 center, int k, int team, float maxRadius, ArenaVector<int>& out) const {
+    out.clear();
+    if(k <= 0)
+        return 0;
+
+    // Les k meilleurs candidats, triés par distance. k est petit : insertion simple
+    ArenaVector<std::pair<float, int>> best(out.get_allocator());
+    best.reserve(k + 1);
+    float maxDistanceSquared = maxRadius * maxRadius;
+    int x = cellCoord(center.x), y = cellCoord(center.y);
+
+    for(int ring = 0; ; ring++) {
+        forEachInRing(x, y, ring, [&](int entry) {
+            if(!isEnemy(team, m_entryTeams[entry]))
+                return;
+            float distanceSquared = (m_entryPositions[entry] - center).LengthSquared();
+            if(distanceSquared > maxDistanceSquared)
+                return;
+            if((int)best.size() == k && distanceSquared >= best.back().first)
+                return;
+            std::pair<float, int> candidate(distanceSquared, m_entryIndices[entry]);
+            best.insert(std::upper_bound(best.begin(), best.end(), candidate), candidate);
+            if((int)best.size() > k)
+                best.pop_back();
+        });
+
+        float reach = ring * m_cellSize;
+        float boundSquared = (int)best.size() == k ? best.back().first : maxDistanceSquared;
+        if(reach * reach >= boundSquared || coversAllCells(x, y, ring))
+            break;
+    }
+
+    for(const std::pair<float, int>& candidate : best)
+        out.push_back(candidate.second);
+    return (int)out.size();
+}
@@ -0,0 +1,156 @@
+#pragma once
+
+#include <box2d/b2_math.h>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "frame_arena.hpp"
+
+/**
+ * @class SpatialGrid
+ * @brief Uniform hash grid over points (circle centres), rebuilt from scratch every tick.
+ *
+ * The cells are squares of a fixed size hashed into a power-of-two bucket table, so the arena
+ * has no bounds. The build is a counting sort of the points by bucket (linear time), and the
+ * points of a bucket are stored contiguously with their team for the queries.
+ * With circles of the same size and a cell of one diameter, a radius query only reads the few
+ * cells around the query point. The queries that return lists fill an ArenaVector: the results are
+ * scratch data of the tick.
+ */
+class SpatialGrid {
+public:
+    static constexpr int ANY_TEAM = -1; // Team filter that accepts every point
+
+private:
+    float m_cellSize{ 1.f };
+    float m_inverseCellSize{ 1.f };
+    std::uint32_t m_bucketMask{ 0 };
+    std::vector<int> m_bucketStarts; // Index of the first entry of each bucket, plus one past the end
+    std::vector<int> m_entryIndices; // Point index of each entry, entries sorted by bucket
+    std::vector<b2Vec2> m_entryPositions;
+    std::vector<int> m_entryTeams;
+    std::vector<std::int64_t> m_entryCells; // Cell key of each entry, to skip hash collisions
+    std::vector<std::uint32_t> m_pointBuckets; // Bucket of each point, build scratch
+    int m_minCellX{ 0 }, m_minCellY{ 0 }, m_maxCellX{ -1 }, m_maxCellY{ -1 };
+
+    int cellCoord(float value) const { return (int)std::floor(value * m_inverseCellSize); }
+    static std::int64_t cellKey(int x, int y) { return ((std::int64_t)x << 32) | (std::uint32_t)y; }
+    std::uint32_t bucketOf(int x, int y) const {
+        return ((std::uint32_t)x * 73856093u ^ (std::uint32_t)y * 19349663u) & m_bucketMask;
+    }
+    static bool isEnemy(int team, int otherTeam) { return team == ANY_TEAM || otherTeam != team; }
+
+    /**
+     * @brief Calls fn(entry) for every entry of a cell.
+     */
+    template<typename F>
+    void forEachInCell(int x, int y, F&& fn) const;
+
+    /**
+     * @brief Calls fn(entry) for every entry of the cells at Chebyshev distance ring from a cell.
+     */
+    template<typename F>
+    void forEachInRing(int x, int y, int ring, F&& fn) const;
+
+    /**
+     * @brief Tells whether the square of cells at Chebyshev distance <= ring from a cell covers every point.
+     */
+    bool coversAllCells(int x, int y, int ring) const;
+
+public:
+    /**
+     * @brief Rebuilds the grid over a set of points.
+     * @param positionX The x coordinate of each point, in meters.
+     * @param positionY The y coordinate of each point, in meters.
+     * @param teams The team of each point.
+     * @param cellSize The side of a cell, in meters. One circle diameter is a good choice.
+     */
+    void build(const std::vector<float>& positionX, const std::vector<float>& positionY,
+               const std::vector<std::uint8_t>& teams, float cellSize);
+
+    /**
+     * @brief Calls fn(index, position) for every point within a radius of a centre.
+     * @param center The centre, in meters.
+     * @param radius The radius, in meters.
+     * @param team Only points of another team are reported, ANY_TEAM reports them all.
+     * @param fn The callback.
+     */
+    template<typename F>
+    void forEachInRadius(b2Vec2 center, float radius, int team, F&& fn) const;
+
+    /**
+     * @brief Collects the points within a radius of a centre ("enemies within R").
+     * @param center The centre, in meters.
+     * @param radius The radius, in meters.
+     * @param team Only points of another team are returned, ANY_TEAM returns them all.
+     * @param out Receives the point indices, in no particular order. Cleared first.
+     * @return The number of points found.
+     */
+    int queryRadius(b2Vec2 center, float radius, int team, ArenaVector<int>& out) const;
+
+    /**
+     * @brief Finds the closest point to a centre ("nearest enemy").
+     * @param center The centre, in meters.
+     * @param team Only points of another team are considered, ANY_TEAM considers them all.
+     * @param maxRadius Points further than this are ignored, in meters.
+     * @return The point index, -1 if there is none.
+     */
+    int findNearest(b2Vec2 center, int team, float maxRadius) const;
+
+    /**
+     * @brief Finds the k closest points to a centre.
+     * @param center The centre, in meters.
+     * @param k The maximum number of points.
+     * @param team Only points of another team are considered, ANY_TEAM considers them all.
+     * @param maxRadius Points further than this are ignored, in meters.
+     * @param out Receives the point indices, closest first. Cleared first. Its arena also holds the candidates.
+     * @return The number of points found.
+     */
+    int findKNearest(b2Vec2 center, int k, int team, float maxRadius, ArenaVector<int>& out) const;
+
+    float getCellSize() const { return m_cellSize; }
+};
+
+template<typename F>
+void SpatialGrid::forEachInCell(int x, int y, F&& fn) const {
+    if(m_entryIndices.empty())
+        return;
+    std::uint32_t bucket = bucketOf(x, y);
+    std::int64_t key = cellKey(x, y);
+    for(int entry = m_bucketStarts[bucket]; entry < m_bucketStarts[bucket + 1]; entry++) {
+        if(m_entryCells[entry] == key)
+            fn(entry);
+    }
+}
+
+template<typename F>
+void SpatialGrid::forEachInRing(int x, int y, int ring, F&& fn) const {
+    if(ring == 0) {
+        forEachInCell(x, y, fn);
+        return;
+    }
+    for(int i = -ring; i <= ring; i++) {
+        forEachInCell(x + i, y - ring, fn);
+        forEachInCell(x + i, y + ring, fn);
+    }
+    for(int i = -ring + 1; i <= ring - 1; i++) {
+        forEachInCell(x - ring, y + i, fn);
+        forEachInCell(x + ring, y + i, fn);
+    }
+}
+
+template<typename F>
+void SpatialGrid::forEachInRadius(b2Vec2 center, float radius, int team, F&& fn) const {
+    float radiusSquared = radius * radius;
+    int minX = cellCoord(center.x - radius), maxX = cellCoord(center.x + radius);
+    int minY = cellCoord(center.y - radius), maxY = cellCoord(center.y + radius);
+    for(int y = minY; y <= maxY; y++) {
+        for(int x = minX; x <= maxX; x++) {
+            forEachInCell(x, y, [&](int entry) {
+                if(isEnemy(team, m_entryTeams[entry]) && (m_entryPositions[entry] - center).LengthSquared() <= radiusSquared)
+                    fn(m_entryIndices[entry], m_entryPositions[entry]);
+            });
+        }
+    }
+}
@@ -0,0 +1,84 @@
+#include "steering.hpp"
+
+#include "circle.hpp"
+#include "constants.hpp"
+#include "simd.hpp"
+#include "utils.hpp"
+
+static constexpr float INV_TWO_PI = 1.f / (2 * Utils::PI);
+static constexpr float TWO_PI_HI = 6.28125f; // 2 pi en deux morceaux : turns * TWO_PI_HI est exact
+static constexpr float TWO_PI_LO = 1.93530717e-3f;
+
+static constexpr float TURN_STEP = MAX_ANGULAR_SPEED_BOT * Utils::PI / 180.f; // Rotation maximale d'une décision (rad)
+static constexpr float INV_TURN_STEP = 1.f / TURN_STEP;
+static constexpr float TURN_DEADZONE = 0.005f; // En dessous, Circle::botControl() ne tourne pas (|2 * movingAngle| <= 0.01)
+
+// Le seuil de vitesse de Circle::botControl() est négatif : sa branche "marche arrière" n'est jamais prise
+static_assert(-180.0f / MAX_ANGULAR_SPEED_BOT / 2.0f < 0.f, "the reverse branch of Circle::botControl() must be ported");
+// Les masques sont rangés dans l'ordre des bits de std::bitset<4>
+static_assert(Circle::Up == 0 && Circle::Down == 1 && Circle::Right == 2 && Circle::Left == 3, "controls are packed in Direction order");
+
+/**
+ * @brief Computes the controls of V::WIDTH agents starting at index first.
+ *
+ * Branchless translation of Circle::botControl(): each condition becomes a lane mask.
+ */
+template<typename V>
+static void steerLanes(const float* positionX, const float* positionY, const float* angle,
+                       const float* velocityX, const float* velocityY,
+                       const float* targetX, const float* targetY,
+                       std::uint8_t* controls, int first) {
+    using Float = typename V::Float;
+    using Mask = typename V::Mask;
+
+    Float deltaX = V::sub(V::load(targetX + first), V::load(positionX + first));
+    Float deltaY = V::sub(V::load(targetY + first), V::load(positionY + first));
+    Float angleDiff = V::sub(Utils::atan2Lanes<Utils::Accuracy::Fine, V>(deltaY, deltaX), V::load(angle + first));
+
+    // Ramène dans [-pi, pi] en une fois, à la place des boucles while
+    Float turns = V::round(V::mul(angleDiff, V::set(INV_TWO_PI)));
+    angleDiff = V::sub(V::sub(angleDiff, V::mul(turns, V::set(TWO_PI_HI))), V::mul(turns, V::set(TWO_PI_LO)));
+    Float absDiff = V::abs(angleDiff);
+
+    Float velX = V::load(velocityX + first), velY = V::load(velocityY + first);
+    Float speed = V::sqrt(V::add(V::mul(velX, velX), V::mul(velY, velY)));
+
+    // nbRotationBefore90 >= 1 et trop rapide : on lève le pied (== 1) ou on freine (> 1)
+    Float rotationsBefore90 = V::floor(V::mul(V::sub(absDiff, V::set(Utils::PI / 2)), V::set(INV_TURN_STEP)));
+    Mask slowDown = V::both(V::greater(absDiff, V::set(TURN_STEP)),
+                            V::both(V::greater(rotationsBefore90, V::set(0.f)),
+                                    V::greater(speed, V::sub(V::set(MAX_SPEED_BOT), rotationsBefore90))));
+    Mask brake = V::both(slowDown, V::greater(rotationsBefore90, V::set(1.f)));
+
+    V::storeBitBytes(V::negate(slowDown), brake, V::greater(angleDiff, V::set(TURN_DEADZONE)),
+                     V::less(angleDiff, V::set(-TURN_DEADZONE)), controls + first);
+}
+
+/**
+ * @brief Computes the bot controls needed to steer each agent toward its target.
+ * @param positionX The x coordinate of each agent, in meters.
+ * @param positionY The y coordinate of each agent, in meters.
+ * @param angle The body angle of each agent, in radians.
+ * @param velocityX The x velocity of each agent, in m/s.
+ * @param velocityY The y velocity of each agent, in m/s.
+ * @param targetX The x coordinate of the target of each agent, in meters.
+ * @param targetY The y coordinate of the target of each agent, in meters.
+ * @param controls Receives the controls of each agent (std::bitset<4> bits, indexed by Circle::Direction).
+ * @param count The number of agents.
+ */
+void Steering::computeBotControls(const float* positionX, const float* positionY, const float* angle,
+                                  const float* velocityX, const float* velocityY,
+                                  const float* targetX, const float* targetY,
+                                  std::uint8_t* controls, int count) {
+    forEachSimdBlock(count, [&](auto lanes, int first) {
+        steerLanes<decltype(lanes)>(positionX, positionY, angle, velocityX, velocityY, targetX, targetY, controls, first);
+    });
+}
+
+/**
+ * @brief Gets the instruction set the batched controller was compiled for.
+ * @return "AVX2", "SSE2" or "scalar".
+ */
+const char* Steering::getInstructionSet() {
+    return getSimdInstructionSet();
+}
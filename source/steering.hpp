@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @class Steering
+ * @brief Batched version of Circle::botControl(), computing the controls of many bots at once.
+ *
+ * The inputs are structure-of-arrays (see AgentStore) and the bots are processed with the lane
+ * types of simd.hpp: 8 at a time with AVX2, 4 at a time with SSE2, one at a time otherwise. Every
+ * path runs the same float operations in the same order, so they give the same controls on every machine.
+ *
+ * The controls match Circle::botControl() except when the angle to the target is within the error
+ * of Utils::fastAtan2() at the Fine level (2e-6 rad, plus float rounding) of a decision threshold.
+ */
+class Steering {
+public:
+    /**
+     * @brief Computes the bot controls needed to steer each agent toward its target.
+     * @param positionX The x coordinate of each agent, in meters.
+     * @param positionY The y coordinate of each agent, in meters.
+     * @param angle The body angle of each agent, in radians.
+     * @param velocityX The x velocity of each agent, in m/s.
+     * @param velocityY The y velocity of each agent, in m/s.
+     * @param targetX The x coordinate of the target of each agent, in meters.
+     * @param targetY The y coordinate of the target of each agent, in meters.
+     * @param controls Receives the controls of each agent (std::bitset<4> bits, indexed by Circle::Direction).
+     * @param count The number of agents.
+     */
+    static void computeBotControls(const float* positionX, const float* positionY, const float* angle,
+                                   const float* velocityX, const float* velocityY,
+                                   const float* targetX, const float* targetY,
+                                   std::uint8_t* controls, int count);
+
+    /**
+     * @brief Gets the instruction set the batched controller was compiled for.
+     * @return "AVX2", "SSE2" or "scalar".
+     */
+    static const char* getInstructionSet();
+};
@@ -0,0 +1,104 @@
+#include "thread_pool.hpp"
+
+#include "trace.hpp"
+
+static thread_local const ThreadPool* t_threadPool = nullptr; // Pool of the worker running on this thread
+static thread_local int t_threadIndex = 0;
+
+/**
+ * @brief Starts the worker threads.
+ * @param threadCount The total number of threads, calling thread included. 0 uses every hardware thread.
+ */
+ThreadPool::ThreadPool(int threadCount) {
+    if(threadCount <= 0)
+        threadCount = std::max(1, (int)std::thread::hardware_concurrency());
+
+    m_workers.reserve(threadCount - 1);
+    for(int i = 1; i < threadCount; i++)
+        m_workers.emplace_back(&ThreadPool::workerLoop, this, i);
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wakeCondition.notify_all();
+    for(std::thread& worker : m_workers)
+        worker.join();
+}
+
+/**
+ * @brief Calls task(i) for every i in [0, count) across the threads, and waits for all of them.
+ * @param count The number of iterations.
+ * @param task The loop body, called concurrently from several threads.
+ */
+void ThreadPool::parallelFor(int count, const std::function<void(int)>& task) {
+    if(count <= 0)
+        return;
+    if(m_workers.empty() || count == 1) {
+        for(int i = 0; i < count; i++)
+            task(i);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_task = &task;
+        m_taskCount = count;
+        m_nextIndex = 0;
+        m_pendingWorkers = (int)m_workers.size();
+        m_generation++;
+    }
+    m_wakeCondition.notify_all();
+
+    runTasks(task, count);
+
+    // Chaque worker doit avoir vu cette boucle avant d'en lancer une autre
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_doneCondition.wait(lock, [this] { return m_pendingWorkers == 0; });
+    m_task = nullptr;
+    AllocationTracker::chargeToThread(m_workerAllocations);
+    m_workerAllocations = {};
+}
+
+/**
+ * @brief Gets the index of the calling thread in this pool: 1 to getThreadCount() - 1 for its workers, 0 for any
+ * other thread (the one calling parallelFor(), or a worker of another pool). Lets a loop body pick per-thread scratch data.
+ */
+int ThreadPool::getThreadIndex() const {
+    return t_threadPool == this ? t_threadIndex : 0;
+}
+
+void ThreadPool::workerLoop(int index) {
+    t_threadPool = this;
+    t_threadIndex = index;
+    Trace::setThreadName("pool worker");
+    long long seenGeneration = 0;
+    while(true) {
+        const std::function<void(int)>* task;
+        int count;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wakeCondition.wait(lock, [&] { return m_stopping || m_generation != seenGeneration; });
+            if(m_stopping)
+                return;
+            seenGeneration = m_generation;
+            task = m_task;
+            count = m_taskCount;
+        }
+
+        AllocationScope allocations;
+        runTasks(*task, count);
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_workerAllocations += allocations.getCounts();
+        if(--m_pendingWorkers == 0)
+            m_doneCondition.notify_one();
+    }
+}
+
+void ThreadPool::runTasks(const std::function<void(int)>& task, int count) {
+    for(int i = m_nextIndex.fetch_add(1); i < count; i = m_nextIndex.fetch_add(1))
+        task(i);
+}
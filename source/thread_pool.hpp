@@ -0,0 +1,66 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "allocation_tracker.hpp"
+
+/**
+ * @class ThreadPool
+ * @brief Fixed set of worker threads that share the iterations of a parallel loop.
+ *
+ * The calling thread takes part in the loop, so a pool of N threads owns N - 1 workers.
+ * The heap allocations made by the workers during a loop are charged to the calling thread
+ * (see AllocationTracker), as if it had run the whole loop itself.
+ */
+class ThreadPool {
+private:
+    std::vector<std::thread> m_workers;
+    std::mutex m_mutex;
+    std::condition_variable m_wakeCondition;
+    std::condition_variable m_doneCondition;
+    const std::function<void(int)>* m_task{ nullptr };
+    int m_taskCount{ 0 };
+    std::atomic<int> m_nextIndex{ 0 };
+    int m_pendingWorkers{ 0 }; // Workers that have not finished the current loop yet
+    long long m_generation{ 0 }; // Incremented for every loop, wakes the workers up
+    bool m_stopping{ false };
+    AllocationCounts m_workerAllocations; // Made by the workers during the current loop
+
+    void workerLoop(int index);
+    void runTasks(const std::function<void(int)>& task, int count);
+
+public:
+    /**
+     * @brief Starts the worker threads.
+     * @param threadCount The total number of threads, calling thread included. 0 uses every hardware thread.
+     */
+    explicit ThreadPool(int threadCount = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * @brief Calls task(i) for every i in [0, count) across the threads, and waits for all of them.
+     * @param count The number of iterations.
+     * @param task The loop body, called concurrently from several threads.
+     */
+    void parallelFor(int count, const std::function<void(int)>& task);
+
+    /**
+     * @brief Gets the total number of threads running the loops, calling thread included.
+     */
+    int getThreadCount() const { return (int)m_workers.size() + 1; }
+
+    /**
+     * @brief Gets the index of the calling thread in this pool: 1 to getThreadCount() - 1 for its workers, 0 for any
+     * other thread (the one calling parallelFor(), or a worker of another pool). Lets a loop body pick per-thread scratch data.
+     */
+    int getThreadIndex() const;
+};
@@ -0,0 +1,167 @@
+#include "trace.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/**
+ * @struct TraceEvent
+ * @brief One complete event ("ph": "X") of the trace.
+ */
+struct TraceEvent {
+    const char* name;
+    long long begin; // ns
+    long long end; // ns
+};
+
+/**
+ * @struct TraceThreadBuffer
+ * @brief Ring buffer of the events of one thread.
+ */
+struct TraceThreadBuffer {
+    std::vector<TraceEvent> events; // Alloué une fois, à la première utilisation par le thread
+    std::size_t next{ 0 }; // Slot of the next event
+    bool wrapped{ false }; // The oldest events were overwritten
+    std::string name;
+    int threadID{ 0 };
+};
+
+static std::atomic<bool> s_enabled{ false };
+static std::chrono::steady_clock::time_point s_startTime;
+static std::mutex s_buffersMutex; // Protège la liste, pas les événements : chaque thread écrit seul dans le sien
+static std::vector<std::unique_ptr<TraceThreadBuffer>> s_buffers;
+static thread_local TraceThreadBuffer* t_buffer = nullptr;
+
+/**
+ * @brief Gets the buffer of the calling thread, creating it the first time.
+ */
+static TraceThreadBuffer& getThreadBuffer() {
+    if(!t_buffer) {
+        std::lock_guard<std::mutex> lock(s_buffersMutex);
+        s_buffers.push_back(std::make_unique<TraceThreadBuffer>());
+        t_buffer = s_buffers.back().get();
+        t_buffer->events.resize(Trace::EVENTS_PER_THREAD);
+        t_buffer->threadID = (int)s_buffers.size();
+    }
+    return *t_buffer;
+}
+
+/**
+ * @brief Writes a string as a JSON string literal.
+ */
+static void writeJsonString(std::ostream& out, const std::string& text) {
+    out << '"';
+    for(char c : text) {
+        if(c == '"' || c == '\\')
+            out << '\\';
+        out << c;
+    }
+    out << '"';
+}
+
+/**
+ * @brief Starts recording, the timestamps of the file start here.
+ */
+void Trace::start() {
+    s_startTime = std::chrono::steady_clock::now();
+    s_enabled = true;
+}
+
+/**
+ * @brief Stops recording. The buffers are kept until save().
+ */
+void Trace::stop() {
+    s_enabled = false;
+}
+
+bool Trace::isEnabled() {
+    return s_enabled.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Names the calling thread in the trace.
+ * @param name The name, e.g. "simulation".
+ */
+void Trace::setThreadName(const char* name) {
+    if(isEnabled())
+        getThreadBuffer().name = name;
+}
+
+/**
+ * @brief Records a complete event on the calling thread.
+ * @param name The name, a string literal: only the pointer is kept.
+ * @param beginNanoseconds The start, see now().
+ * @param endNanoseconds The end, see now().
+ */
+void Trace::record(const char* name, long long beginNanoseconds, long long endNanoseconds) {
+    TraceThreadBuffer& buffer = getThreadBuffer();
+    buffer.events[buffer.next] = { name, beginNanoseconds, endNanoseconds };
+    if(++buffer.next == buffer.events.size()) {
+        buffer.next = 0;
+        buffer.wrapped = true;
+    }
+}
+
+/**
+ * @brief Gets the current time on the trace clock.
+ * @return The time since start(), in ns.
+ */
+long long Trace::now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - s_startTime).count();
+}
+
+/**
+ * @brief Writes every recorded event as Chrome trace_event JSON.
+ *
+ * The traced threads must be idle (stopped, or waiting for work) while saving.
+ * @param path The file to write.
+ * @return false if the file cannot be written.
+ */
+bool Trace::save(const std::string& path) {
+    std::ofstream file(path);
+    if(!file)
+        return false;
+
+    std::lock_guard<std::mutex> lock(s_buffersMutex);
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    bool first = true;
+    for(const std::unique_ptr<TraceThreadBuffer>& buffer : s_buffers) {
+        if(!buffer->name.empty()) {
+            file << (first ? "" : ",\n") << "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":" << buffer->threadID << ",\"args\":{\"name\":";
+            writeJsonString(file, buffer->name);
+            file << "}}";
+            first = false;
+        }
+
+        // Du plus ancien au plus récent : après un tour complet, le plus ancien est à next
+        std::size_t count = buffer->wrapped ? buffer->events.size() : buffer->next;
+        std::size_t oldest = buffer->wrapped ? buffer->next : 0;
+        for(std::size_t i = 0; i < count; i++) {
+            const TraceEvent& event = buffer->events[(oldest + i) % buffer->events.size()];
+            file << (first ? "" : ",\n") << "{\"ph\":\"X\",\"name\":";
+            writeJsonString(file, event.name);
+            // Microsecondes, avec les nanosecondes en décimales
+            file << ",\"pid\":1,\"tid\":" << buffer->threadID << ",\"ts\":" << event.begin / 1000 << '.' << event.begin % 1000 / 100
+                 << ",\"dur\":" << (event.end - event.begin) / 1000 << '.' << (event.end - event.begin) % 1000 / 100 << "}";
+            first = false;
+        }
+    }
+    file << "\n]}\n";
+    return (bool)file;
+}
+
+/**
+ * @brief Starts the event, if tracing is on.
+ * @param name The name, a string literal.
+ */
+TraceScope::TraceScope(const char* name)
+    : m_name(Trace::isEnabled() ? name : nullptr), m_begin(m_name ? Trace::now() : 0) {
+}
+
+TraceScope::~TraceScope() {
+    if(m_name)
+        Trace::record(m_name, m_begin, Trace::now());
+}
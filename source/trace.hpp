@@ -0,0 +1,79 @@
+#pragma once
+
+#include <string>
+
+/**
+ * @class Trace
+ * @brief Timeline of scoped markers, saved as Chrome trace_event JSON (Perfetto, chrome://tracing).
+ *
+ * Every thread records into its own ring buffer of EVENTS_PER_THREAD events, allocated the
+ * first time it records: there is no lock and no allocation per event, and a long session keeps
+ * its last events. When tracing is off a marker costs one relaxed atomic load.
+ */
+class Trace {
+public:
+    static constexpr int EVENTS_PER_THREAD = 1 << 16;
+
+    /**
+     * @brief Starts recording, the timestamps of the file start here.
+     */
+    static void start();
+
+    /**
+     * @brief Stops recording. The buffers are kept until save().
+     */
+    static void stop();
+
+    static bool isEnabled();
+
+    /**
+     * @brief Names the calling thread in the trace.
+     * @param name The name, e.g. "simulation".
+     */
+    static void setThreadName(const char* name);
+
+    /**
+     * @brief Records a complete event on the calling thread.
+     * @param name The name, a string literal: only the pointer is kept.
+     * @param beginNanoseconds The start, see now().
+     * @param endNanoseconds The end, see now().
+     */
+    static void record(const char* name, long long beginNanoseconds, long long endNanoseconds);
+
+    /**
+     * @brief Gets the current time on the trace clock.
+     * @return The time since start(), in ns.
+     */
+    static long long now();
+
+    /**
+     * @brief Writes every recorded event as Chrome trace_event JSON.
+     *
+     * The traced threads must be idle (stopped, or waiting for work) while saving.
+     * @param path The file to write.
+     * @return false if the file cannot be written.
+     */
+    static bool save(const std::string& path);
+};
+
+/**
+ * @class TraceScope
+ * @brief Records the time between its construction and its destruction as one trace event, see TRACE_SCOPE.
+ */
+class TraceScope {
+private:
+    const char* m_name; // nullptr when tracing was off at construction
+    long long m_begin;
+
+public:
+    explicit TraceScope(const char* name);
+    ~TraceScope();
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+};
+
+#define TRACE_CONCAT_IMPL(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_IMPL(a, b)
+// Marque le reste du bloc courant dans la trace, name doit être une chaîne littérale
+#define TRACE_SCOPE(name) TraceScope TRACE_CONCAT(traceScope, __LINE__)(name)
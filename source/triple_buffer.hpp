@@ -0,0 +1,58 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+
+/**
+ * @class TripleBuffer
+ * @brief Lock-free hand-over of the latest value from one writer thread to one reader thread.
+ *
+ * The writer fills the back buffer and publishes it by swapping it with the middle one; the reader
+ * swaps the middle buffer with its front one when a new value is there. Neither side ever waits:
+ * the writer overwrites values the reader skipped, the reader keeps its value until a new one comes.
+ */
+template<typename T>
+class TripleBuffer {
+private:
+    static constexpr int INDEX_MASK = 0x3;
+    static constexpr int NEW_BIT = 0x4; // Set in m_middle when it holds a value the reader has not taken
+
+    std::array<T, 3> m_buffers;
+    std::atomic<int> m_middle{ 1 };
+    int m_back{ 0 }; // Writer thread only
+    int m_front{ 2 }; // Reader thread only
+
+public:
+    /**
+     * @brief Gets the buffer to fill. Writer thread only.
+     */
+    T& getWriteBuffer() { return m_buffers[m_back]; }
+
+    /**
+     * @brief Hands the filled buffer over to the reader. Writer thread only.
+     */
+    void publish() {
+        m_back = m_middle.exchange(m_back | NEW_BIT, std::memory_order_acq_rel) & INDEX_MASK;
+    }
+
+    /**
+     * @brief Tells whether the reader has taken the last published buffer, e.g. to skip filling values it would skip. Writer thread only.
+     */
+    bool isTaken() const { return !(m_middle.load(std::memory_order_relaxed) & NEW_BIT); }
+
+    /**
+     * @brief Takes the last published buffer, if there is a new one. Reader thread only.
+     * @return true if getReadBuffer() changed.
+     */
+    bool update() {
+        if(!(m_middle.load(std::memory_order_relaxed) & NEW_BIT))
+            return false;
+        m_front = m_middle.exchange(m_front, std::memory_order_acq_rel) & INDEX_MASK;
+        return true;
+    }
+
+    /**
+     * @brief Gets the last buffer taken by update(). Reader thread only.
+     */
+    const T& getReadBuffer() const { return m_buffers[m_front]; }
+};
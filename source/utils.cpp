@@ -1,20 +1,178 @@
-#include "utils.hpp"
-
-sf::Vector2f Utils::polarToCartesian(float radius, float angleRad) {
-    return sf::Vector2f(radius * std::cos(angleRad), radius * std::sin(angleRad));
-}
-
-
-std::pair<float, float> Utils::cartesianToPolar(const sf::Vector2f& vec) {
-    float radius = std::sqrt(vec.x * vec.x + vec.y * vec.y);
-    float angleRad = std::atan2(vec.y, vec.x);
-    return { radius, angleRad };
-}
-
-float Utils::deg2Rad(float degrees) {
-    return degrees * 3.14159265f / 180.f;
-}
-
-float Utils::rad2Deg(float radians) {
-    return radians * 180.f / 3.14159265f;
-}
+#include "utils.hpp"
+
+#include <cmath>
+
+sf::Vector2f Utils::polarToCartesian(float radius, float angleRad, Accuracy accuracy) {
+    float sine, cosine;
+    fastSinCos(angleRad, sine, cosine, accuracy);
+    return sf::Vector2f(radius * cosine, radius * sine);
+}
+
+/**
+ * @brief Converts polar coordinates to cartesian ones when the rotation is already known, without any trig.
+ * @param radius The radius.
+ * @param rotation The rotation, e.g. from a body transform.
+ */
+sf::Vector2f Utils::polarToCartesian(float radius, const b2Rot& rotation) {
+    return sf::Vector2f(radius * rotation.c, radius * rotation.s);
+}
+
+
+std::pair<float, float> Utils::cartesianToPolar(const sf::Vector2f& vec, Accuracy accuracy) {
+    float radius = fastSqrt(vec.x * vec.x + vec.y * vec.y, accuracy);
+    float angleRad = fastAtan2(vec.y, vec.x, accuracy);
+    return { radius, angleRad };
+}
+
+float Utils::deg2Rad(float degrees) {
+    return degrees * PI / 180.f;
+}
+
+float Utils::rad2Deg(float radians) {
+    return radians * 180.f / PI;
+}
+
+/**
+ * @brief Approximates sin and cos of the same angle, sharing the range reduction.
+ * @param angleRad The angle, in radians. The error grows slowly beyond a few thousand radians.
+ * @param sine Receives the sine.
+ * @param cosine Receives the cosine.
+ * @param accuracy The precision level.
+ */
+void Utils::fastSinCos(float angleRad, float& sine, float& cosine, Accuracy accuracy) {
+    switch(accuracy) {
+        case Accuracy::Coarse: sinCosLanes<Accuracy::Coarse, ScalarFloats>(angleRad, sine, cosine); break;
+        case Accuracy::Fine: sinCosLanes<Accuracy::Fine, ScalarFloats>(angleRad, sine, cosine); break;
+        default:
+            sine = std::sin(angleRad);
+            cosine = std::cos(angleRad);
+            break;
+    }
+}
+
+float Utils::fastSin(float angleRad, Accuracy accuracy) {
+    float sine, cosine;
+    fastSinCos(angleRad, sine, cosine, accuracy);
+    return sine;
+}
+
+float Utils::fastCos(float angleRad, Accuracy accuracy) {
+    float sine, cosine;
+    fastSinCos(angleRad, sine, cosine, accuracy);
+    return cosine;
+}
+
+/**
+ * @brief Approximates atan2.
+ * @param y The y coordinate.
+ * @param x The x coordinate.
+ * @param accuracy The precision level.
+ * @return The angle in [-pi, pi]. 0 for (0, 0).
+ */
+float Utils::fastAtan2(float y, float x, Accuracy accuracy) {
+    switch(accuracy) {
+        case Accuracy::Coarse: return atan2Lanes<Accuracy::Coarse, ScalarFloats>(y, x);
+        case Accuracy::Fine: return atan2Lanes<Accuracy::Fine, ScalarFloats>(y, x);
+        default: return std::atan2(y, x);
+    }
+}
+
+/**
+ * @brief Approximates the square root from an inverse square root estimate.
+ * @param value The value, >= 0.
+ * @param accuracy The precision level.
+ * @return The square root. 0 for 0.
+ */
+float Utils::fastSqrt(float value, Accuracy accuracy) {
+    switch(accuracy) {
+        case Accuracy::Coarse: return sqrtLanes<Accuracy::Coarse, ScalarFloats>(value);
+        case Accuracy::Fine: return sqrtLanes<Accuracy::Fine, ScalarFloats>(value);
+        default: return std::sqrt(value);
+    }
+}
+
+// Une boucle par niveau : le choix de précision est fait une fois, hors de la boucle
+template<Utils::Accuracy A>
+static void sinCosLoop(const float* angles, float* sines, float* cosines, int count) {
+    forEachSimdBlock(count, [&](auto lanes, int first) {
+        using V = decltype(lanes);
+        typename V::Float sine, cosine;
+        Utils::sinCosLanes<A, V>(V::load(angles + first), sine, cosine);
+        V::store(sines + first, sine);
+        V::store(cosines + first, cosine);
+    });
+}
+
+template<Utils::Accuracy A>
+static void atan2Loop(const float* y, const float* x, float* angles, int count) {
+    forEachSimdBlock(count, [&](auto lanes, int first) {
+        using V = decltype(lanes);
+        V::store(angles + first, Utils::atan2Lanes<A, V>(V::load(y + first), V::load(x + first)));
+    });
+}
+
+template<Utils::Accuracy A>
+static void sqrtLoop(const float* values, float* roots, int count) {
+    forEachSimdBlock(count, [&](auto lanes, int first) {
+        using V = decltype(lanes);
+        V::store(roots + first, Utils::sqrtLanes<A, V>(V::load(values + first)));
+    });
+}
+
+/**
+ * @brief Computes sin and cos of count angles.
+ * @param angles The angles, in radians.
+ * @param sines Receives the sines.
+ * @param cosines Receives the cosines.
+ * @param count The number of angles.
+ * @param accuracy The precision level.
+ */
+void Utils::sinCosArray(const float* angles, float* sines, float* cosines, int count, Accuracy accuracy) {
+    switch(accuracy) {
+        case Accuracy::Coarse: sinCosLoop<Accuracy::Coarse>(angles, sines, cosines, count); break;
+        case Accuracy::Fine: sinCosLoop<Accuracy::Fine>(angles, sines, cosines, count); break;
+        default:
+            for(int i = 0; i < count; i++) {
+                sines[i] = std::sin(angles[i]);
+                cosines[i] = std::cos(angles[i]);
+            }
+            break;
+    }
+}
+
+/**
+ * @brief Computes atan2 of count points.
+ * @param y The y coordinates.
+ * @param x The x coordinates.
+ * @param angles Receives the angles.
+ * @param count The number of points.
+ * @param accuracy The precision level.
+ */
+void Utils::atan2Array(const float* y, const float* x, float* angles, int count, Accuracy accuracy) {
+    switch(accuracy) {
+        case Accuracy::Coarse: atan2Loop<Accuracy::Coarse>(y, x, angles, count); break;
+        case Accuracy::Fine: atan2Loop<Accuracy::Fine>(y, x, angles, count); break;
+        default:
+            for(int i = 0; i < count; i++)
+                angles[i] = std::atan2(y[i], x[i]);
+            break;
+    }
+}
+
+/**
+ * @brief Computes the square root of count values.
+ * @param values The values, >= 0.
+ * @param roots Receives the square roots.
+ * @param count The number of values.
+ * @param accuracy The precision level.
+ */
+void Utils::sqrtArray(const float* values, float* roots, int count, Accuracy accuracy) {
+    switch(accuracy) {
+        case Accuracy::Coarse: sqrtLoop<Accuracy::Coarse>(values, roots, count); break;
+        case Accuracy::Fine: sqrtLoop<Accuracy::Fine>(values, roots, count); break;
+        default:
+            for(int i = 0; i < count; i++)
+                roots[i] = std::sqrt(values[i]);
+            break;
+    }
+}
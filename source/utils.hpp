@@ -1,12 +1,190 @@
-#pragma once 
-
-#include <SFML/Graphics.hpp>
-
-class Utils
-{
-public:
-    static sf::Vector2f polarToCartesian(float radius, float angleRad);
-    static std::pair<float, float> cartesianToPolar(const sf::Vector2f& vec);
-    static float deg2Rad(float degrees);
-    static float rad2Deg(float radians);
-};
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <box2d/b2_math.h>
+#include <utility>
+
+#include "simd.hpp"
+
+/**
+ * @class Utils
+ * @brief Angle conversions and fast approximations of the math functions used every tick.
+ *
+ * Each approximation takes an Accuracy: Coarse and Fine are branchless polynomials (or an inverse
+ * square root estimate for sqrt), written once over the lane types of simd.hpp so that the array
+ * versions run 4 or 8 values at a time. Exact calls the standard library.
+ * The maximum errors are given next to each level, measured against the double precision functions
+ * (see MathBenchmark).
+ */
+class Utils
+{
+public:
+    static constexpr float PI = 3.14159265358979323846f;
+
+    /**
+     * @enum Accuracy
+     * @brief Precision of the approximations, from the cheapest to the standard library.
+     */
+    enum class Accuracy {
+        Coarse, // sin/cos 1e-4, atan2 1.6e-3 rad, sqrt 2e-3 relative : enough for drawing
+        Fine, // sin/cos 1e-6, atan2 2e-6 rad, sqrt 5e-6 relative : enough for the simulation
+        Exact // std::sin, std::cos, std::atan2, std::sqrt
+    };
+
+    static sf::Vector2f polarToCartesian(float radius, float angleRad, Accuracy accuracy = Accuracy::Exact);
+    static sf::Vector2f polarToCartesian(float radius, const b2Rot& rotation);
+    static std::pair<float, float> cartesianToPolar(const sf::Vector2f& vec, Accuracy accuracy = Accuracy::Exact);
+    static float deg2Rad(float degrees);
+    static float rad2Deg(float radians);
+
+    /**
+     * @brief Approximates sin and cos of the same angle, sharing the range reduction.
+     * @param angleRad The angle, in radians. The error grows slowly beyond a few thousand radians.
+     * @param sine Receives the sine.
+     * @param cosine Receives the cosine.
+     * @param accuracy The precision level.
+     */
+    static void fastSinCos(float angleRad, float& sine, float& cosine, Accuracy accuracy = Accuracy::Fine);
+    static float fastSin(float angleRad, Accuracy accuracy = Accuracy::Fine);
+    static float fastCos(float angleRad, Accuracy accuracy = Accuracy::Fine);
+
+    /**
+     * @brief Approximates atan2.
+     * @param y The y coordinate.
+     * @param x The x coordinate.
+     * @param accuracy The precision level.
+     * @return The angle in [-pi, pi]. 0 for (0, 0).
+     */
+    static float fastAtan2(float y, float x, Accuracy accuracy = Accuracy::Fine);
+
+    /**
+     * @brief Approximates the square root from an inverse square root estimate.
+     * @param value The value, >= 0.
+     * @param accuracy The precision level.
+     * @return The square root. 0 for 0.
+     */
+    static float fastSqrt(float value, Accuracy accuracy = Accuracy::Fine);
+
+    /**
+     * @brief Computes sin and cos of count angles.
+     * @param angles The angles, in radians.
+     * @param sines Receives the sines.
+     * @param cosines Receives the cosines.
+     * @param count The number of angles.
+     * @param accuracy The precision level.
+     */
+    static void sinCosArray(const float* angles, float* sines, float* cosines, int count, Accuracy accuracy = Accuracy::Fine);
+
+    /**
+     * @brief Computes atan2 of count points.
+     * @param y The y coordinates.
+     * @param x The x coordinates.
+     * @param angles Receives the angles.
+     * @param count The number of points.
+     * @param accuracy The precision level.
+     */
+    static void atan2Array(const float* y, const float* x, float* angles, int count, Accuracy accuracy = Accuracy::Fine);
+
+    /**
+     * @brief Computes the square root of count values.
+     * @param values The values, >= 0.
+     * @param roots Receives the square roots.
+     * @param count The number of values.
+     * @param accuracy The precision level.
+     */
+    static void sqrtArray(const float* values, float* roots, int count, Accuracy accuracy = Accuracy::Fine);
+
+    /**
+     * @brief sin and cos of V::WIDTH angles at once, Coarse or Fine.
+     */
+    template<Accuracy A, typename V>
+    static void sinCosLanes(typename V::Float angleRad, typename V::Float& sine, typename V::Float& cosine);
+
+    /**
+     * @brief atan2 of V::WIDTH points at once, Coarse or Fine.
+     */
+    template<Accuracy A, typename V>
+    static typename V::Float atan2Lanes(typename V::Float y, typename V::Float x);
+
+    /**
+     * @brief Square root of V::WIDTH values at once, Coarse or Fine.
+     */
+    template<Accuracy A, typename V>
+    static typename V::Float sqrtLanes(typename V::Float value);
+};
+
+template<Utils::Accuracy A, typename V>
+void Utils::sinCosLanes(typename V::Float angleRad, typename V::Float& sine, typename V::Float& cosine) {
+    static_assert(A != Accuracy::Exact, "Exact goes through the standard library");
+    using Float = typename V::Float;
+
+    // angle = k * pi + x avec x dans [-pi/2, pi/2] (pi en deux morceaux : k * 3.140625 est exact), puis signe (-1)^k
+    Float turns = V::round(V::mul(angleRad, V::set(1.f / PI)));
+    Float x = V::sub(V::sub(angleRad, V::mul(turns, V::set(3.140625f))), V::mul(turns, V::set(9.67653590e-4f)));
+    Float parity = V::sub(turns, V::mul(V::set(2.f), V::floor(V::mul(turns, V::set(0.5f)))));
+    Float sign = V::sub(V::set(1.f), V::mul(V::set(2.f), parity));
+    Float x2 = V::mul(x, x);
+
+    // Polynômes minimax sur [-pi/2, pi/2]
+    Float sinPoly, cosPoly;
+    if constexpr(A == Accuracy::Coarse) {
+        sinPoly = V::add(V::set(-1.656730744e-1f), V::mul(x2, V::set(7.514375563e-3f)));
+        sinPoly = V::add(V::set(9.996967701e-1f), V::mul(x2, sinPoly));
+        cosPoly = V::add(V::set(4.148774744e-2f), V::mul(x2, V::set(-1.271209323e-3f)));
+        cosPoly = V::add(V::set(-4.999124392e-1f), V::mul(x2, cosPoly));
+        cosPoly = V::add(V::set(9.999932952e-1f), V::mul(x2, cosPoly));
+    }
+    else {
+        sinPoly = V::add(V::set(-1.980089808e-4f), V::mul(x2, V::set(2.590489049e-6f)));
+        sinPoly = V::add(V::set(8.332899830e-3f), V::mul(x2, sinPoly));
+        sinPoly = V::add(V::set(-1.666664764e-1f), V::mul(x2, sinPoly));
+        sinPoly = V::add(V::set(9.999999766e-1f), V::mul(x2, sinPoly));
+        cosPoly = V::add(V::set(-1.385370426e-3f), V::mul(x2, V::set(2.315393072e-5f)));
+        cosPoly = V::add(V::set(4.166358469e-2f), V::mul(x2, cosPoly));
+        cosPoly = V::add(V::set(-4.999990535e-1f), V::mul(x2, cosPoly));
+        cosPoly = V::add(V::set(9.999999535e-1f), V::mul(x2, cosPoly));
+    }
+    sine = V::mul(V::mul(x, sinPoly), sign);
+    cosine = V::mul(cosPoly, sign);
+}
+
+template<Utils::Accuracy A, typename V>
+typename V::Float Utils::atan2Lanes(typename V::Float y, typename V::Float x) {
+    static_assert(A != Accuracy::Exact, "Exact goes through the standard library");
+    using Float = typename V::Float;
+
+    // atan de min/max sur [0, 1], puis retour dans le bon octant
+    Float absX = V::abs(x), absY = V::abs(y);
+    Float ratio = V::div(V::min(absX, absY), V::max(V::max(absX, absY), V::set(1e-30f))); // (0, 0) donne 0
+    Float angle;
+    if constexpr(A == Accuracy::Coarse) {
+        // pi/4 a - a (a - 1) (0.2447 + 0.0663 a)
+        Float correction = V::add(V::set(0.2447f), V::mul(V::set(0.0663f), ratio));
+        angle = V::sub(V::mul(V::set(PI / 4), ratio), V::mul(V::mul(ratio, V::sub(ratio, V::set(1.f))), correction));
+    }
+    else {
+        // Polynôme minimax impair de degré 11
+        Float square = V::mul(ratio, ratio);
+        Float poly = V::add(V::set(0.05265332f), V::mul(square, V::set(-0.01172120f)));
+        poly = V::add(V::set(-0.11643287f), V::mul(square, poly));
+        poly = V::add(V::set(0.19354346f), V::mul(square, poly));
+        poly = V::add(V::set(-0.33262347f), V::mul(square, poly));
+        poly = V::add(V::set(0.99997726f), V::mul(square, poly));
+        angle = V::mul(poly, ratio);
+    }
+    angle = V::select(V::greater(absY, absX), V::sub(V::set(PI / 2), angle), angle);
+    angle = V::select(V::less(x, V::set(0.f)), V::sub(V::set(PI), angle), angle);
+    return V::copySign(angle, y);
+}
+
+template<Utils::Accuracy A, typename V>
+typename V::Float Utils::sqrtLanes(typename V::Float value) {
+    static_assert(A != Accuracy::Exact, "Exact goes through the standard library");
+    using Float = typename V::Float;
+
+    // sqrt(v) = v / sqrt(v), Fine ajoute un pas de Newton sur 1/sqrt : y *= 1.5 - v / 2 * y²
+    Float inverse = V::rsqrtEstimate(value);
+    if constexpr(A == Accuracy::Fine)
+        inverse = V::mul(inverse, V::sub(V::set(1.5f), V::mul(V::mul(V::set(0.5f), value), V::mul(inverse, inverse))));
+    return V::select(V::greater(value, V::set(0.f)), V::mul(value, inverse), V::set(0.f)); // 1/sqrt(0) est infini
+}